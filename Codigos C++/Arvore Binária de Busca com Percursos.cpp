@@ -1,20 +1,27 @@
+#include <memory>
+#include <memory_resource>
+
 #include "array_list.h"
 
 namespace structures {
 
-template<typename T>
+template<typename T, typename Allocator = std::allocator<T>>
 class BinaryTree {
 public:
+    BinaryTree() = default;
+
+    explicit BinaryTree(const Allocator& alloc) : alloc_(alloc) {}
+
     ~BinaryTree() {
-        delete root;
+        destroy(alloc_, root);
     }
 
     // Insere um elemento na árvore
     void insert(const T& data) {
         if (root == nullptr) {
-            root = new Node(data);
+            root = create(alloc_, data);
         } else {
-            root->insert(data);
+            root->insert(alloc_, data);
         }
         size_++;
     }
@@ -22,11 +29,11 @@ public:
     // Remove um elemento da árvore
     void remove(const T& data) {
         if (root != nullptr && root->data == data) {
-            delete root;
+            destroy(alloc_, root);
             root = nullptr;
             size_--;
         } else if (root != nullptr) {
-            if (root->remove(data)) {
+            if (root->remove(alloc_, data)) {
                 size_--;
             }
         }
@@ -50,9 +57,14 @@ public:
         return size_;
     }
 
+    // Retorna o alocador usado pelos nós e pelos percursos
+    Allocator get_allocator() const {
+        return Allocator(alloc_);
+    }
+
     // Retorna uma lista com os elementos da árvore em pré-ordem
-    ArrayList<T> pre_order() const {
-        ArrayList<T> result;
+    ArrayList<T, Allocator> pre_order() const {
+        ArrayList<T, Allocator> result(get_allocator());
         if (root != nullptr) {
             root->pre_order(result);
         }
@@ -60,8 +72,8 @@ public:
     }
 
     // Retorna uma lista com os elementos da árvore em ordem simétrica
-    ArrayList<T> in_order() const {
-        ArrayList<T> result;
+    ArrayList<T, Allocator> in_order() const {
+        ArrayList<T, Allocator> result(get_allocator());
         if (root != nullptr) {
             root->in_order(result);
         }
@@ -69,8 +81,8 @@ public:
     }
 
     // Retorna uma lista com os elementos da árvore em pós-ordem
-    ArrayList<T> post_order() const {
-        ArrayList<T> result;
+    ArrayList<T, Allocator> post_order() const {
+        ArrayList<T, Allocator> result(get_allocator());
         if (root != nullptr) {
             root->post_order(result);
         }
@@ -78,58 +90,81 @@ public:
     }
 
 private:
+    struct Node;
+
+    using NodeAllocator =
+        typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+    using NodeTraits = std::allocator_traits<NodeAllocator>;
+
+    // Aloca um nó pelo alocador da árvore
+    static Node* create(NodeAllocator& alloc, const T& data) {
+        Node* node = NodeTraits::allocate(alloc, 1);
+        try {
+            NodeTraits::construct(alloc, node, data);
+        } catch (...) {
+            NodeTraits::deallocate(alloc, node, 1);
+            throw;
+        }
+        return node;
+    }
+
+    // Devolve um nó e toda a sua subárvore ao alocador
+    static void destroy(NodeAllocator& alloc, Node* node) {
+        if (node != nullptr) {
+            destroy(alloc, node->left);
+            destroy(alloc, node->right);
+            NodeTraits::destroy(alloc, node);
+            NodeTraits::deallocate(alloc, node, 1);
+        }
+    }
+
     struct Node {
         explicit Node(const T& data) : data(data),
         left(nullptr),
         right(nullptr) {}
 
-        ~Node() {
-            delete left;
-            delete right;
-        }
-
         T data;
         Node* left;
         Node* right;
 
         // Insere um elemento na subárvore
-        void insert(const T& data_) {
+        void insert(NodeAllocator& alloc, const T& data_) {
             if (data_ < data) {
                 if (left == nullptr) {
-                    left = new Node(data_);
+                    left = create(alloc, data_);
                 } else {
-                    left->insert(data_);
+                    left->insert(alloc, data_);
                 }
             } else if (data_ > data) {
                 if (right == nullptr) {
-                    right = new Node(data_);
+                    right = create(alloc, data_);
                 } else {
-                    right->insert(data_);
+                    right->insert(alloc, data_);
                 }
             }
         }
 
         // Remove um elemento da subárvore
-        bool remove(const T& data_) {
+        bool remove(NodeAllocator& alloc, const T& data_) {
             if (data_ < data) {
                 if (left == nullptr) {
                     return false;
                 } else if (left->data == data_) {
-                    delete left;
+                    destroy(alloc, left);
                     left = nullptr;
                     return true;
                 } else {
-                    return left->remove(data_);
+                    return left->remove(alloc, data_);
                 }
             } else if (data_ > data) {
                 if (right == nullptr) {
                     return false;
                 } else if (right->data == data_) {
-                    delete right;
+                    destroy(alloc, right);
                     right = nullptr;
                     return true;
                 } else {
-                    return right->remove(data_);
+                    return right->remove(alloc, data_);
                 }
             }
             return false;
@@ -154,7 +189,7 @@ private:
         }
 
         // Percorre a subárvore em pré-ordem e adiciona elementos na lista
-        void pre_order(ArrayList<T>& v) const {
+        void pre_order(ArrayList<T, Allocator>& v) const {
             v.push_back(data);
             if (left != nullptr) {
                 left->pre_order(v);
@@ -164,7 +199,7 @@ private:
             }
         }
         // Percorre a subárvore em ordem simétrica e adiciona elementos na lista
-        void in_order(ArrayList<T>& v) const {
+        void in_order(ArrayList<T, Allocator>& v) const {
             if (left != nullptr) {
                 left->in_order(v);
             }
@@ -175,7 +210,7 @@ private:
         }
 
         // Percorre a subárvore em pós-ordem e adiciona elementos na lista
-        void post_order(ArrayList<T>& v) const {
+        void post_order(ArrayList<T, Allocator>& v) const {
             if (left != nullptr) {
                 left->post_order(v);
             }
@@ -186,8 +221,17 @@ private:
         }
     };
 
+    NodeAllocator alloc_{};
     Node* root = nullptr;
     std::size_t size_ = 0u;
 };
 
+namespace pmr {
+
+template<typename T>
+using BinaryTree =
+    structures::BinaryTree<T, std::pmr::polymorphic_allocator<T>>;
+
+}  // namespace pmr
+
 }  // namespace structures
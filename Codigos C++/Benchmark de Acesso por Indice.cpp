@@ -0,0 +1,95 @@
+// Benchmark: at(i) em laco nas listas com dedo (DoublyLinkedList e
+// DoublyCircularList) contra a LinkedList, que anda desde a cabeca.
+// Compilar: g++ -std=c++17 -O2 "Benchmark de Acesso por Indice.cpp"
+
+#include <chrono>  // std::chrono::steady_clock
+#include <cstdint>  // std::size_t, std::uint64_t
+#include <cstdio>  // std::printf
+#include <random>  // std::mt19937_64
+#include <vector>  // std::vector
+
+#include "doubly_circular_list.h"
+#include "doubly_linked_list.h"
+#include "linked_list.h"
+
+namespace {
+
+template<typename F>
+double seconds(F function) {
+    auto start = std::chrono::steady_clock::now();
+    function();
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+//! ns por at() visitando os indices na ordem dada
+template<typename List>
+double scan(List& list, const std::vector<std::size_t>& order,
+            std::uint64_t& checksum) {
+    double elapsed = seconds([&] {
+        for (std::size_t index : order) {
+            checksum += list.at(index);
+        }
+    });
+    return elapsed * 1e9 / order.size();
+}
+
+}  // namespace
+
+int main() {
+    const std::size_t N = 20000u;
+    const std::size_t RANDOM_READS = 20000u;
+    std::uint64_t checksum = 0u;
+
+    structures::LinkedList<std::uint64_t> singly;
+    structures::DoublyLinkedList<std::uint64_t> doubly;
+    structures::DoublyCircularList<std::uint64_t> circular;
+    for (std::size_t i = 0u; i < N; i++) {
+        singly.push_back(i);
+        doubly.push_back(i);
+        circular.push_back(i);
+    }
+
+    std::vector<std::size_t> forward(N);
+    std::vector<std::size_t> backward(N);
+    for (std::size_t i = 0u; i < N; i++) {
+        forward[i] = i;
+        backward[i] = N - 1u - i;
+    }
+    // aleatorio ao redor do ultimo acesso: o caso em que o dedo ajuda
+    // parcialmente, e aleatorio uniforme, em que ele pouco ajuda
+    std::mt19937_64 random(42u);
+    std::vector<std::size_t> nearby(RANDOM_READS);
+    std::vector<std::size_t> uniform(RANDOM_READS);
+    std::size_t position = N / 2u;
+    for (std::size_t i = 0u; i < RANDOM_READS; i++) {
+        position = (position + N + random() % 65u - 32u) % N;
+        nearby[i] = position;
+        uniform[i] = random() % N;
+    }
+
+    struct Pattern {
+        const char* name;
+        const std::vector<std::size_t>* order;
+    };
+    const Pattern patterns[] = {
+        {"frente", &forward},
+        {"tras", &backward},
+        {"vizinho", &nearby},
+        {"uniforme", &uniform},
+    };
+
+    std::printf("%zu elementos, ns por at()\n", N);
+    std::printf("%-10s %12s %12s %12s\n", "percurso", "simples", "dupla",
+                "circular");
+    for (const Pattern& pattern : patterns) {
+        double t_singly = scan(singly, *pattern.order, checksum);
+        double t_doubly = scan(doubly, *pattern.order, checksum);
+        double t_circular = scan(circular, *pattern.order, checksum);
+        std::printf("%-10s %12.1f %12.1f %12.1f\n", pattern.name, t_singly,
+                    t_doubly, t_circular);
+    }
+    std::printf("checksum %llu\n", static_cast<unsigned long long>(checksum));
+    return 0;
+}
@@ -0,0 +1,140 @@
+// Benchmark: LruCache e ClockCache contra o LRU classico de std::list +
+// std::unordered_map, com chaves em distribuicao de Zipf (taxa de acerto
+// e milhoes de operacoes por segundo).
+// Compilar: g++ -std=c++17 -O2 "Benchmark de Cache LRU e CLOCK.cpp"
+
+#include <algorithm>  // std::lower_bound
+#include <chrono>  // std::chrono::steady_clock
+#include <cmath>  // std::pow
+#include <cstdint>  // std::size_t, std::uint64_t
+#include <cstdio>  // std::printf
+#include <list>  // std::list
+#include <random>  // std::mt19937_64
+#include <unordered_map>  // std::unordered_map
+#include <utility>  // std::pair
+#include <vector>  // std::vector
+
+#include "cache.h"
+
+namespace {
+
+//! LRU de livro: lista de pares e mapa chave -> iterador
+class StdLruCache {
+ public:
+    explicit StdLruCache(std::size_t capacity): capacity_{capacity} {}
+
+    std::uint64_t* get(std::uint64_t key) {
+        auto it = map_.find(key);
+        if (it == map_.end()) {
+            misses_++;
+            return nullptr;
+        }
+        hits_++;
+        order_.splice(order_.begin(), order_, it->second);
+        return &it->second->second;
+    }
+
+    void put(std::uint64_t key, std::uint64_t value) {
+        auto it = map_.find(key);
+        if (it != map_.end()) {
+            it->second->second = value;
+            order_.splice(order_.begin(), order_, it->second);
+            return;
+        }
+        if (map_.size() == capacity_) {
+            map_.erase(order_.back().first);
+            order_.pop_back();
+        }
+        order_.emplace_front(key, value);
+        map_[key] = order_.begin();
+    }
+
+    double hit_rate() const {
+        return static_cast<double>(hits_) / (hits_ + misses_);
+    }
+
+ private:
+    using Entry = std::pair<std::uint64_t, std::uint64_t>;
+
+    std::size_t capacity_;
+    std::list<Entry> order_;
+    std::unordered_map<std::uint64_t, std::list<Entry>::iterator> map_;
+    std::uint64_t hits_{0u};
+    std::uint64_t misses_{0u};
+};
+
+template<typename F>
+double seconds(F function) {
+    auto start = std::chrono::steady_clock::now();
+    function();
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+//! count chaves em [0, keys) com P(k) proporcional a 1 / (k + 1)^s
+std::vector<std::uint64_t> zipf(std::size_t keys, double s,
+                                std::size_t count) {
+    std::vector<double> cdf(keys);
+    double sum = 0.0;
+    for (std::size_t k = 0u; k < keys; k++) {
+        sum += 1.0 / std::pow(static_cast<double>(k + 1u), s);
+        cdf[k] = sum;
+    }
+    std::mt19937_64 random(42u);
+    std::uniform_real_distribution<double> uniform(0.0, sum);
+    std::vector<std::uint64_t> samples(count);
+    for (std::uint64_t& sample : samples) {
+        sample = std::lower_bound(cdf.begin(), cdf.end(), uniform(random)) -
+                 cdf.begin();
+    }
+    return samples;
+}
+
+//! le cada chave; na falta, carrega; retorna Mops/s
+template<typename Cache>
+double replay(Cache& cache, const std::vector<std::uint64_t>& keys,
+              std::uint64_t& checksum) {
+    double elapsed = seconds([&] {
+        for (std::uint64_t key : keys) {
+            std::uint64_t* value = cache.get(key);
+            if (value == nullptr) {
+                cache.put(key, key * 2u);
+            } else {
+                checksum += *value;
+            }
+        }
+    });
+    return keys.size() / elapsed / 1e6;
+}
+
+}  // namespace
+
+int main() {
+    const std::size_t KEYS = 1000000u;
+    const std::size_t OPS = 10000000u;
+    std::uint64_t checksum = 0u;
+
+    std::printf("%zu chaves, %zu leituras\n", KEYS, OPS);
+    std::printf("%-6s %-9s %8s %8s %8s %8s %8s %8s\n", "zipf", "capacid.",
+                "std hit", "Mops/s", "lru hit", "Mops/s", "clk hit",
+                "Mops/s");
+    for (double s : {0.8, 0.99}) {
+        std::vector<std::uint64_t> keys = zipf(KEYS, s, OPS);
+        for (std::size_t capacity : {1000u, 10000u, 100000u}) {
+            StdLruCache baseline(capacity);
+            structures::LruCache<std::uint64_t, std::uint64_t> lru(capacity);
+            structures::ClockCache<std::uint64_t, std::uint64_t> clock(
+                capacity);
+            double t_std = replay(baseline, keys, checksum);
+            double t_lru = replay(lru, keys, checksum);
+            double t_clock = replay(clock, keys, checksum);
+            std::printf("%-6.2f %-9zu %8.3f %8.2f %8.3f %8.2f %8.3f %8.2f\n",
+                        s, capacity, baseline.hit_rate(), t_std,
+                        lru.stats().hit_rate(), t_lru,
+                        clock.stats().hit_rate(), t_clock);
+        }
+    }
+    std::printf("checksum %llu\n", static_cast<unsigned long long>(checksum));
+    return 0;
+}
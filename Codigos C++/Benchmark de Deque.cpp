@@ -0,0 +1,106 @@
+// Benchmark: Deque (vetor circular) contra DoublyLinkedList e std::deque
+// inserindo e retirando nas duas pontas, e no acesso por indice.
+// Compilar: g++ -std=c++17 -O2 "Benchmark de Deque.cpp"
+
+#include <chrono>  // std::chrono::steady_clock
+#include <cstdint>  // std::size_t, std::uint64_t
+#include <cstdio>  // std::printf
+#include <deque>  // std::deque
+
+#include "deque.h"
+#include "doubly_linked_list.h"
+
+namespace {
+
+template<typename F>
+double seconds(F function) {
+    auto start = std::chrono::steady_clock::now();
+    function();
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+//! std::deque com pop_* que retornam o valor, como as estruturas daqui
+class StdDeque {
+ public:
+    void push_back(std::uint64_t data) { deque_.push_back(data); }
+    void push_front(std::uint64_t data) { deque_.push_front(data); }
+    std::uint64_t pop_back() {
+        std::uint64_t data = deque_.back();
+        deque_.pop_back();
+        return data;
+    }
+    std::uint64_t pop_front() {
+        std::uint64_t data = deque_.front();
+        deque_.pop_front();
+        return data;
+    }
+    std::uint64_t& at(std::size_t index) { return deque_.at(index); }
+
+ private:
+    std::deque<std::uint64_t> deque_;
+};
+
+struct Times {
+    double fill;  // n push_back + n push_front
+    double churn;  // passos de push numa ponta e pop na outra
+    double index;  // leitura por at em ordem
+    double drain;  // retirar tudo alternando as pontas
+};
+
+//! ns por operacao em cada fase
+template<typename Deque>
+Times run(std::size_t n, std::uint64_t& checksum) {
+    Deque deque;
+    Times times;
+    times.fill = seconds([&] {
+        for (std::size_t i = 0u; i < n; i++) {
+            deque.push_back(i);
+            deque.push_front(i);
+        }
+    }) * 1e9 / (2u * n);
+    times.churn = seconds([&] {
+        for (std::size_t i = 0u; i < n; i++) {
+            deque.push_back(i);
+            checksum += deque.pop_front();
+            deque.push_front(i);
+            checksum += deque.pop_back();
+        }
+    }) * 1e9 / (4u * n);
+    const std::size_t READS = 100000u;  // saltos longos anulam o dedo
+    times.index = seconds([&] {
+        for (std::size_t i = 0u; i < READS; i++) {
+            checksum += deque.at(i * 7919u % (2u * n));
+        }
+    }) * 1e9 / READS;
+    times.drain = seconds([&] {
+        for (std::size_t i = 0u; i < n; i++) {
+            checksum += deque.pop_front();
+            checksum += deque.pop_back();
+        }
+    }) * 1e9 / (2u * n);
+    return times;
+}
+
+void print(const char* name, const Times& times) {
+    std::printf("%-14s %10.2f %10.2f %10.1f %10.2f\n", name, times.fill,
+                times.churn, times.index, times.drain);
+}
+
+}  // namespace
+
+int main() {
+    const std::size_t N = 1000000u;
+    std::uint64_t checksum = 0u;
+
+    std::printf("%zu elementos em cada ponta, ns por operacao\n", N);
+    std::printf("%-14s %10s %10s %10s %10s\n", "", "encher", "rodar",
+                "at", "esvaziar");
+    print("Deque", run<structures::Deque<std::uint64_t>>(N, checksum));
+    print("lista dupla",
+          run<structures::DoublyLinkedList<std::uint64_t>>(N, checksum));
+    print("std::deque", run<StdDeque>(N, checksum));
+    std::printf("checksum %llu\n", static_cast<unsigned long long>(checksum));
+    return 0;
+}
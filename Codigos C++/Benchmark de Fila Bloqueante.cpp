@@ -0,0 +1,154 @@
+// Benchmark: BlockingQueue contra uma fila com trava e variavel de
+// condicao sem giros, e contra um consumidor que testa e dorme 1 ms:
+// latencia de push ate o pop acordar e CPU gasta com a fila parada.
+// Compilar: g++ -std=c++17 -O2 -pthread "Benchmark de Fila Bloqueante.cpp"
+
+#include <sys/resource.h>  // getrusage
+
+#include <algorithm>  // std::sort
+#include <chrono>  // std::chrono::steady_clock
+#include <condition_variable>  // std::condition_variable
+#include <cstdint>  // std::size_t, std::int64_t
+#include <cstdio>  // std::printf
+#include <mutex>  // std::mutex, std::unique_lock
+#include <thread>  // std::thread, std::this_thread::sleep_for
+#include <vector>  // std::vector
+
+#include "array_queue.h"
+#include "blocking_queue.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+//! fila bloqueante de livro: cada pop vazio dorme direto no wait
+class CondvarQueue {
+ public:
+    explicit CondvarQueue(std::size_t max): queue_(max) {}
+
+    bool push(const std::int64_t& data) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            queue_.enqueue(data);
+        }
+        not_empty_.notify_one();
+        return true;
+    }
+
+    bool pop(std::int64_t& data) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        not_empty_.wait(lock, [this] { return !queue_.empty(); });
+        data = queue_.dequeue();
+        return true;
+    }
+
+ private:
+    std::mutex mutex_;
+    std::condition_variable not_empty_;
+    structures::ArrayQueue<std::int64_t> queue_;
+};
+
+//! consumidor por sondagem: testa e, se vazia, dorme 1 ms
+class PollingQueue {
+ public:
+    explicit PollingQueue(std::size_t max): queue_(max) {}
+
+    bool push(const std::int64_t& data) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        queue_.enqueue(data);
+        return true;
+    }
+
+    bool pop(std::int64_t& data) {
+        for (;;) {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (!queue_.empty()) {
+                    data = queue_.dequeue();
+                    return true;
+                }
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+ private:
+    std::mutex mutex_;
+    structures::ArrayQueue<std::int64_t> queue_;
+};
+
+std::int64_t now_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        Clock::now().time_since_epoch()).count();
+}
+
+//! segundos de CPU (usuario + sistema) do processo ate agora
+double cpu_seconds() {
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_utime.tv_sec + usage.ru_utime.tv_usec * 1e-6 +
+           usage.ru_stime.tv_sec + usage.ru_stime.tv_usec * 1e-6;
+}
+
+struct Result {
+    double median_us;
+    double p99_us;
+    double idle_cpu;  // fracao de um nucleo com a fila parada
+};
+
+//! o consumidor espera em pop; o produtor empurra a hora atual a cada
+//! GAP e o consumidor anota quanto demorou para acordar. Depois a fila
+//! fica parada por IDLE enquanto se mede a CPU do processo
+template<typename Queue>
+Result measure(std::size_t samples) {
+    const auto GAP = std::chrono::microseconds(200);
+    const auto IDLE = std::chrono::milliseconds(500);
+    Queue queue(64u);
+    std::vector<double> latencies;
+    latencies.reserve(samples);
+    std::thread consumer([&] {
+        std::int64_t sent;
+        for (std::size_t i = 0u; i < samples; i++) {
+            queue.pop(sent);
+            latencies.push_back((now_ns() - sent) / 1e3);
+        }
+        queue.pop(sent);  // espera o sinal de fim, parada
+    });
+    for (std::size_t i = 0u; i < samples; i++) {
+        std::this_thread::sleep_for(GAP);
+        queue.push(now_ns());
+    }
+    std::this_thread::sleep_for(GAP * 10);  // deixa o consumidor dormir
+    double cpu_before = cpu_seconds();
+    auto start = Clock::now();
+    std::this_thread::sleep_for(IDLE);
+    double cpu = cpu_seconds() - cpu_before;
+    std::chrono::duration<double> wall = Clock::now() - start;
+    queue.push(0);
+    consumer.join();
+
+    std::sort(latencies.begin(), latencies.end());
+    Result result;
+    result.median_us = latencies[latencies.size() / 2u];
+    result.p99_us = latencies[latencies.size() * 99u / 100u];
+    result.idle_cpu = cpu / wall.count();
+    return result;
+}
+
+void print(const char* name, const Result& result) {
+    std::printf("%-18s %12.1f %12.1f %12.2f%%\n", name, result.median_us,
+                result.p99_us, result.idle_cpu * 100.0);
+}
+
+}  // namespace
+
+int main() {
+    const std::size_t SAMPLES = 2000u;
+    std::printf("%-18s %12s %12s %13s\n", "", "mediana us", "p99 us",
+                "CPU parada");
+    print("BlockingQueue",
+          measure<structures::BlockingQueue<std::int64_t>>(SAMPLES));
+    print("trava + condicao", measure<CondvarQueue>(SAMPLES));
+    print("sondagem 1 ms", measure<PollingQueue>(SAMPLES));
+    return 0;
+}
@@ -0,0 +1,130 @@
+// Benchmark: SpscQueue contra ArrayQueue protegida por um std::mutex,
+// com um produtor e um consumidor: vazao e latencia de ida e volta.
+// Compilar: g++ -std=c++17 -O2 -pthread "Benchmark de Fila Circular SPSC.cpp"
+
+#include <chrono>  // std::chrono::steady_clock
+#include <cstdint>  // std::size_t, std::uint64_t
+#include <cstdio>  // std::printf
+#include <mutex>  // std::mutex, std::lock_guard
+#include <thread>  // std::thread, std::this_thread::yield
+
+#include "array_queue.h"
+#include "spsc_queue.h"
+
+namespace {
+
+const std::size_t CAPACITY = 1024u;
+
+//! ArrayQueue com uma trava e a mesma interface limitada da SpscQueue
+class LockedQueue {
+ public:
+    explicit LockedQueue(std::size_t max): max_size_{max} {
+        queue_.reserve(max);
+    }
+
+    bool try_enqueue(std::uint64_t data) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (queue_.size() == max_size_) {
+            return false;
+        }
+        queue_.enqueue(data);
+        return true;
+    }
+
+    bool try_dequeue(std::uint64_t& data) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (queue_.empty()) {
+            return false;
+        }
+        data = queue_.dequeue();
+        return true;
+    }
+
+ private:
+    std::mutex mutex_;
+    structures::ArrayQueue<std::uint64_t> queue_;
+    std::size_t max_size_;
+};
+
+template<typename F>
+double seconds(F function) {
+    auto start = std::chrono::steady_clock::now();
+    function();
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+//! cede o processador ate a operacao dar certo
+template<typename Operation>
+void spin(Operation operation) {
+    while (!operation()) {
+        std::this_thread::yield();
+    }
+}
+
+//! milhoes de elementos por segundo de um produtor a um consumidor
+template<typename Queue>
+double throughput(std::size_t count, std::uint64_t& checksum) {
+    Queue queue(CAPACITY);
+    std::uint64_t sum = 0u;
+    double elapsed = seconds([&] {
+        std::thread consumer([&] {
+            std::uint64_t data;
+            for (std::size_t i = 0u; i < count; i++) {
+                spin([&] { return queue.try_dequeue(data); });
+                sum += data;
+            }
+        });
+        for (std::size_t i = 0u; i < count; i++) {
+            spin([&] { return queue.try_enqueue(i); });
+        }
+        consumer.join();
+    });
+    checksum += sum;
+    return count / elapsed / 1e6;
+}
+
+//! ns de ida e volta: um elemento vai por uma fila e volta pela outra
+template<typename Queue>
+double round_trip(std::size_t count, std::uint64_t& checksum) {
+    Queue ping(CAPACITY);
+    Queue pong(CAPACITY);
+    double elapsed = seconds([&] {
+        std::thread echo([&] {
+            std::uint64_t data;
+            for (std::size_t i = 0u; i < count; i++) {
+                spin([&] { return ping.try_dequeue(data); });
+                spin([&] { return pong.try_enqueue(data); });
+            }
+        });
+        std::uint64_t data;
+        for (std::size_t i = 0u; i < count; i++) {
+            spin([&] { return ping.try_enqueue(i); });
+            spin([&] { return pong.try_dequeue(data); });
+            checksum += data;
+        }
+        echo.join();
+    });
+    return elapsed * 1e9 / count;
+}
+
+}  // namespace
+
+int main() {
+    const std::size_t COUNT = 20000000u;
+    const std::size_t TRIPS = 200000u;
+    std::uint64_t checksum = 0u;
+
+    std::printf("%-26s %12s %12s\n", "", "trava", "spsc");
+    std::printf("%-26s %12.2f %12.2f\n", "vazao Melem/s",
+                throughput<LockedQueue>(COUNT, checksum),
+                throughput<structures::SpscQueue<std::uint64_t>>(COUNT,
+                                                                 checksum));
+    std::printf("%-26s %12.0f %12.0f\n", "ida e volta ns",
+                round_trip<LockedQueue>(TRIPS, checksum),
+                round_trip<structures::SpscQueue<std::uint64_t>>(TRIPS,
+                                                                 checksum));
+    std::printf("checksum %llu\n", static_cast<unsigned long long>(checksum));
+    return 0;
+}
@@ -0,0 +1,185 @@
+// Benchmark: MpmcQueue (um a um e em lotes) contra ArrayQueue protegida
+// por um std::mutex, com 1, 2, 4 e 8 produtores e consumidores.
+// Compilar: g++ -std=c++17 -O2 -pthread "Benchmark de Fila MPMC.cpp"
+
+#include <atomic>  // std::atomic
+#include <chrono>  // std::chrono::steady_clock
+#include <cstdint>  // std::size_t, std::uint64_t
+#include <cstdio>  // std::printf
+#include <mutex>  // std::mutex, std::lock_guard
+#include <thread>  // std::thread, std::this_thread::yield
+#include <vector>  // std::vector
+
+#include "array_queue.h"
+#include "mpmc_queue.h"
+
+namespace {
+
+const std::size_t CAPACITY = 1024u;
+const std::size_t ITEMS = 4000000u;  // total, dividido entre as threads
+const std::size_t BATCH = 32u;
+
+//! ArrayQueue com uma trava e a mesma interface limitada da MpmcQueue
+class LockedQueue {
+ public:
+    explicit LockedQueue(std::size_t max): max_size_{max} {
+        queue_.reserve(max);
+    }
+
+    bool try_enqueue(std::uint64_t data) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (queue_.size() == max_size_) {
+            return false;
+        }
+        queue_.enqueue(data);
+        return true;
+    }
+
+    bool try_dequeue(std::uint64_t& data) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (queue_.empty()) {
+            return false;
+        }
+        data = queue_.dequeue();
+        return true;
+    }
+
+ private:
+    std::mutex mutex_;
+    structures::ArrayQueue<std::uint64_t> queue_;
+    std::size_t max_size_;
+};
+
+template<typename F>
+double seconds(F function) {
+    auto start = std::chrono::steady_clock::now();
+    function();
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+//! uma operacao por elemento, cedendo o processador quando cheia/vazia
+struct Single {
+    template<typename Queue>
+    static void produce(Queue& queue, std::uint64_t first, std::size_t n) {
+        for (std::size_t i = 0u; i < n; i++) {
+            while (!queue.try_enqueue(first + i)) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    template<typename Queue>
+    static std::uint64_t consume(Queue& queue, std::size_t n) {
+        std::uint64_t sum = 0u;
+        std::uint64_t data;
+        for (std::size_t i = 0u; i < n; i++) {
+            while (!queue.try_dequeue(data)) {
+                std::this_thread::yield();
+            }
+            sum += data;
+        }
+        return sum;
+    }
+};
+
+//! try_enqueue_bulk / try_dequeue_bulk de ate BATCH elementos
+struct Bulk {
+    template<typename Queue>
+    static void produce(Queue& queue, std::uint64_t first, std::size_t n) {
+        std::uint64_t buffer[BATCH];
+        std::size_t done = 0u;
+        while (done < n) {
+            std::size_t count = n - done < BATCH ? n - done : BATCH;
+            for (std::size_t i = 0u; i < count; i++) {
+                buffer[i] = first + done + i;
+            }
+            std::size_t sent = 0u;
+            while (sent < count) {
+                std::size_t k =
+                    queue.try_enqueue_bulk(buffer + sent, count - sent);
+                if (k == 0u) {
+                    std::this_thread::yield();
+                }
+                sent += k;
+            }
+            done += count;
+        }
+    }
+
+    template<typename Queue>
+    static std::uint64_t consume(Queue& queue, std::size_t n) {
+        std::uint64_t sum = 0u;
+        std::uint64_t buffer[BATCH];
+        std::size_t done = 0u;
+        while (done < n) {
+            std::size_t want = n - done < BATCH ? n - done : BATCH;
+            std::size_t k = queue.try_dequeue_bulk(buffer, want);
+            if (k == 0u) {
+                std::this_thread::yield();
+            }
+            for (std::size_t i = 0u; i < k; i++) {
+                sum += buffer[i];
+            }
+            done += k;
+        }
+        return sum;
+    }
+};
+
+//! milhoes de elementos por segundo com threads produtores e threads
+//! consumidores; confere a soma do que saiu
+template<typename Queue, typename Mode>
+double run(std::size_t threads, bool& ok) {
+    Queue queue(CAPACITY);
+    std::atomic<bool> go{false};
+    std::atomic<std::uint64_t> total{0u};
+    std::vector<std::thread> pool;
+    std::size_t share = ITEMS / threads;
+    for (std::size_t t = 0u; t < threads; t++) {
+        pool.emplace_back([&, t] {
+            while (!go.load()) {
+                std::this_thread::yield();
+            }
+            Mode::produce(queue, t * share, share);
+        });
+        pool.emplace_back([&] {
+            while (!go.load()) {
+                std::this_thread::yield();
+            }
+            total += Mode::consume(queue, share);
+        });
+    }
+    double elapsed = seconds([&] {
+        go = true;
+        for (std::thread& thread : pool) {
+            thread.join();
+        }
+    });
+    std::uint64_t n = share * threads;
+    ok = ok && total.load() == n * (n - 1u) / 2u;
+    return n / elapsed / 1e6;
+}
+
+}  // namespace
+
+int main() {
+    bool ok = true;
+    std::printf("%zu elementos, capacidade %zu, Melem/s\n", ITEMS, CAPACITY);
+    std::printf("%-10s %10s %10s %10s\n", "prod/cons", "trava", "mpmc",
+                "mpmc lote");
+    for (std::size_t threads : {1u, 2u, 4u, 8u}) {
+        using Queue = structures::MpmcQueue<std::uint64_t>;
+        double locked = run<LockedQueue, Single>(threads, ok);
+        double single = run<Queue, Single>(threads, ok);
+        double bulk = run<Queue, Bulk>(threads, ok);
+        std::printf("%-10zu %10.2f %10.2f %10.2f\n", threads, locked, single,
+                    bulk);
+    }
+    if (!ok) {
+        std::printf("soma errada\n");
+        return 1;
+    }
+    return 0;
+}
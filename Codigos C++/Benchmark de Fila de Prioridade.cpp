@@ -0,0 +1,103 @@
+// Benchmark: PriorityQueue (heap 4-ario) contra a lista ordenada por
+// insert_sorted + pop_front e contra std::priority_queue, no modelo
+// "hold": fila com n elementos, cada passo retira o topo e insere outro.
+// Compilar: g++ -std=c++17 -O2 "Benchmark de Fila de Prioridade.cpp"
+
+#include <chrono>  // std::chrono::steady_clock
+#include <cstdint>  // std::size_t, std::uint64_t
+#include <cstdio>  // std::printf
+#include <functional>  // std::greater
+#include <queue>  // std::priority_queue
+#include <random>  // std::mt19937_64
+#include <vector>  // std::vector
+
+#include "linked_list.h"
+#include "priority_queue.h"
+
+namespace {
+
+template<typename F>
+double seconds(F function) {
+    auto start = std::chrono::steady_clock::now();
+    function();
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+//! std::priority_queue com o menor no topo, na interface da PriorityQueue
+class StdQueue {
+ public:
+    void push(std::uint64_t data) { queue_.push(data); }
+    std::uint64_t pop() {
+        std::uint64_t data = queue_.top();
+        queue_.pop();
+        return data;
+    }
+
+ private:
+    std::priority_queue<std::uint64_t, std::vector<std::uint64_t>,
+                        std::greater<std::uint64_t>> queue_;
+};
+
+//! a lista ordenada que era usada como fila de prioridade
+class SortedList {
+ public:
+    void push(std::uint64_t data) { list_.insert_sorted(data); }
+    std::uint64_t pop() { return list_.pop_front(); }
+
+ private:
+    structures::LinkedList<std::uint64_t> list_;
+};
+
+//! PriorityQueue descartando os handles
+class HeapQueue {
+ public:
+    void push(std::uint64_t data) { queue_.push(data); }
+    std::uint64_t pop() { return queue_.pop(); }
+
+ private:
+    structures::PriorityQueue<std::uint64_t> queue_;
+};
+
+//! ns por passo (pop + push) com a fila mantida em n elementos; o novo
+//! elemento vem depois do retirado, como prazos de eventos
+template<typename Queue>
+double hold(std::size_t n, std::size_t steps, std::uint64_t& checksum) {
+    Queue queue;
+    std::mt19937_64 random(42u);
+    for (std::size_t i = 0u; i < n; i++) {
+        queue.push(random() % 1000000u);
+    }
+    return seconds([&] {
+        for (std::size_t i = 0u; i < steps; i++) {
+            std::uint64_t top = queue.pop();
+            checksum += top;
+            queue.push(top + random() % 1000000u);
+        }
+    }) * 1e9 / steps;
+}
+
+}  // namespace
+
+int main() {
+    const std::size_t STEPS = 200000u;
+    const std::size_t LIST_LIMIT = 10000u;  // lista: O(n) por passo
+    std::uint64_t checksum = 0u;
+
+    std::printf("ns por passo (pop + push)\n");
+    std::printf("%-10s %14s %14s %14s\n", "n", "lista ordenada", "heap 4-ario",
+                "std::pq");
+    for (std::size_t n : {100u, 1000u, 10000u, 100000u, 1000000u}) {
+        std::printf("%-10zu ", n);
+        if (n <= LIST_LIMIT) {
+            std::printf("%14.1f ", hold<SortedList>(n, STEPS, checksum));
+        } else {
+            std::printf("%14s ", "-");
+        }
+        std::printf("%14.1f %14.1f\n", hold<HeapQueue>(n, STEPS, checksum),
+                    hold<StdQueue>(n, STEPS, checksum));
+    }
+    std::printf("checksum %llu\n", static_cast<unsigned long long>(checksum));
+    return 0;
+}
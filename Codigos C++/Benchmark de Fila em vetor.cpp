@@ -0,0 +1,114 @@
+// Benchmark: ArrayQueue (anel potencia de dois, mascara) contra a fila
+// circular antiga (resto da divisao por max_size_ a cada operacao).
+// Compilar: g++ -std=c++17 -O2 "Benchmark de Fila em vetor.cpp"
+
+#include <chrono>  // std::chrono::steady_clock
+#include <cstdint>  // std::size_t, std::uint64_t
+#include <cstdio>  // std::printf
+#include <stdexcept>  // C++ exceptions
+
+#include "array_queue.h"
+
+namespace {
+
+//! fila circular como era antes: capacidade fixa e operador %
+template<typename T>
+class ModuloQueue {
+ public:
+    explicit ModuloQueue(std::size_t max):
+        contents{new T[max]},
+        max_size_{max}
+    {}
+    ~ModuloQueue() { delete[] contents; }
+
+    void enqueue(const T& data) {
+        if (size_ == max_size_) {
+            throw std::out_of_range("fila cheia");
+        }
+        contents[end_] = data;
+        end_ = (end_ + 1u) % max_size_;
+        size_++;
+    }
+
+    T dequeue() {
+        if (size_ == 0u) {
+            throw std::out_of_range("fila vazia");
+        }
+        T data = contents[begin_];
+        begin_ = (begin_ + 1u) % max_size_;
+        size_--;
+        return data;
+    }
+
+ private:
+    T* contents;
+    std::size_t max_size_;
+    std::size_t begin_{0u};
+    std::size_t end_{0u};
+    std::size_t size_{0u};
+};
+
+template<typename F>
+double seconds(F function) {
+    auto start = std::chrono::steady_clock::now();
+    function();
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+//! fila pela metade; cada passo enfileira um e desenfileira um
+template<typename Queue>
+double churn(Queue& queue, std::size_t capacity, std::size_t ops,
+             std::uint64_t& checksum) {
+    for (std::size_t i = 0u; i < capacity / 2u; i++) {
+        queue.enqueue(i);
+    }
+    return seconds([&] {
+        for (std::size_t i = 0u; i < ops; i++) {
+            queue.enqueue(i);
+            checksum += queue.dequeue();
+        }
+    });
+}
+
+}  // namespace
+
+int main() {
+    const std::size_t OPS = 20000000u;
+    std::uint64_t checksum = 0u;
+
+    std::printf("%-10s %14s %14s\n", "capacidade", "modulo ns/op",
+                "mascara ns/op");
+    // capacidades que nao sao potencia de dois: o anel arredonda para cima
+    for (std::size_t capacity : {100u, 1000u, 100000u}) {
+        ModuloQueue<std::uint64_t> modulo(capacity);
+        structures::ArrayQueue<std::uint64_t> masked(capacity);
+        double t_modulo = churn(modulo, capacity, OPS, checksum);
+        double t_masked = churn(masked, capacity, OPS, checksum);
+        std::printf("%-10zu %14.2f %14.2f\n", capacity,
+                    t_modulo * 1e9 / OPS, t_masked * 1e9 / OPS);
+    }
+
+    // crescimento: a fila antiga lancava excecao quando enchia
+    const std::size_t N = 10000000u;
+    double t_grow = seconds([&] {
+        structures::ArrayQueue<std::uint64_t> queue;
+        for (std::size_t i = 0u; i < N; i++) {
+            queue.enqueue(i);
+        }
+        checksum += queue.size();
+    });
+    double t_reserved = seconds([&] {
+        structures::ArrayQueue<std::uint64_t> queue;
+        queue.reserve(N);
+        for (std::size_t i = 0u; i < N; i++) {
+            queue.enqueue(i);
+        }
+        checksum += queue.size();
+    });
+    std::printf("%zu enqueues: crescendo %.2f ns/op, com reserve %.2f ns/op\n",
+                N, t_grow * 1e9 / N, t_reserved * 1e9 / N);
+    std::printf("checksum %llu\n", static_cast<unsigned long long>(checksum));
+    return 0;
+}
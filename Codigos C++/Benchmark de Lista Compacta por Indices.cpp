@@ -0,0 +1,110 @@
+// Benchmark: IndexLinkedList (vetores paralelos, indices de 32 bits)
+// contra DoublyLinkedList (nodos do SlabAllocator): insercao, percurso
+// antes e depois de remocoes espalhadas, compact e bytes por elemento.
+// Compilar: g++ -std=c++17 -O2 "Benchmark de Lista Compacta por Indices.cpp"
+
+#include <chrono>  // std::chrono::steady_clock
+#include <cstdint>  // std::size_t, std::uint64_t
+#include <cstdio>  // std::printf
+#include <random>  // std::mt19937_64
+
+#include "doubly_linked_list.h"
+#include "index_linked_list.h"
+
+namespace {
+
+template<typename F>
+double seconds(F function) {
+    auto start = std::chrono::steady_clock::now();
+    function();
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+//! ns por elemento para somar a lista toda pelo cursor
+template<typename List>
+double traverse(List& list, std::uint64_t& checksum) {
+    double elapsed = seconds([&] {
+        for (auto it = list.cursor(); !it.end(); it.advance()) {
+            checksum += it.data();
+        }
+    });
+    return elapsed * 1e9 / list.size();
+}
+
+//! rounds vezes: retira uns 30% ao acaso e repoe o mesmo tanto nas
+//! pontas, para que a ordem da lista deixe de seguir a da memoria
+template<typename List>
+double churn(List& list, std::size_t rounds) {
+    std::mt19937_64 random(7u);
+    return seconds([&] {
+        for (std::size_t round = 0u; round < rounds; round++) {
+            std::size_t erased = 0u;
+            for (auto it = list.cursor(); !it.end();) {
+                if (random() % 10u < 3u) {
+                    it.erase();
+                    erased++;
+                } else {
+                    it.advance();
+                }
+            }
+            for (std::size_t i = 0u; i < erased; i++) {
+                if (i % 2u == 0u) {
+                    list.push_back(i);
+                } else {
+                    list.push_front(i);
+                }
+            }
+        }
+    });
+}
+
+}  // namespace
+
+int main() {
+    const std::size_t N = 1000000u;
+    const std::size_t ROUNDS = 4u;
+    std::uint64_t checksum = 0u;
+
+    structures::IndexLinkedList<std::uint64_t> compact;
+    structures::DoublyLinkedList<std::uint64_t> nodes;
+
+    std::size_t slab_before = structures::slab_counters().bytes;
+    double push_compact = seconds([&] {
+        for (std::size_t i = 0u; i < N; i++) {
+            compact.push_back(i);
+        }
+    });
+    double push_nodes = seconds([&] {
+        for (std::size_t i = 0u; i < N; i++) {
+            nodes.push_back(i);
+        }
+    });
+    std::size_t slab_bytes = structures::slab_counters().bytes - slab_before;
+    // dado mais next e prev de 32 bits por posicao reservada
+    std::size_t compact_bytes = compact.capacity() *
+        (sizeof(std::uint64_t) + 2u * sizeof(std::uint32_t));
+
+    std::printf("%zu elementos de 8 bytes\n", N);
+    std::printf("%-24s %12s %12s\n", "", "indices", "nodos");
+    std::printf("%-24s %12.1f %12.1f\n", "bytes por elemento",
+                static_cast<double>(compact_bytes) / N,
+                static_cast<double>(slab_bytes) / N);
+    std::printf("%-24s %12.2f %12.2f\n", "push_back ns",
+                push_compact * 1e9 / N, push_nodes * 1e9 / N);
+    std::printf("%-24s %12.2f %12.2f\n", "percurso ns (em ordem)",
+                traverse(compact, checksum), traverse(nodes, checksum));
+    double churn_compact = churn(compact, ROUNDS);
+    double churn_nodes = churn(nodes, ROUNDS);
+    std::printf("%-24s %12.3f %12.3f\n", "remove/repoe s",
+                churn_compact, churn_nodes);
+    std::printf("%-24s %12.2f %12.2f\n", "percurso ns (espalhada)",
+                traverse(compact, checksum), traverse(nodes, checksum));
+    double t_compact = seconds([&] { compact.compact(); });
+    std::printf("%-24s %12.2f %12s\n", "percurso ns (compact)",
+                traverse(compact, checksum), "-");
+    std::printf("compact levou %.3f s\n", t_compact);
+    std::printf("checksum %llu\n", static_cast<unsigned long long>(checksum));
+    return 0;
+}
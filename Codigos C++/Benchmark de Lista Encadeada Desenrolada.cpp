@@ -0,0 +1,77 @@
+// Benchmark: UnrolledLinkedList (varios elementos por nodo) contra a
+// LinkedList (um por nodo): memoria por elemento e varredura com find.
+// Compilar: g++ -std=c++17 -O2 "Benchmark de Lista Encadeada Desenrolada.cpp"
+
+#include <chrono>  // std::chrono::steady_clock
+#include <cstdint>  // std::size_t, std::uint64_t
+#include <cstdio>  // std::printf
+
+#include "linked_list.h"
+#include "unrolled_linked_list.h"
+
+namespace {
+
+template<typename F>
+double seconds(F function) {
+    auto start = std::chrono::steady_clock::now();
+    function();
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+struct Result {
+    double bytes;  // bytes de bloco do SlabAllocator por elemento
+    double fill_ns;  // por push_back
+    double scan_ns;  // por elemento visitado em find
+    double at_ns;  // por at em posicoes espalhadas
+};
+
+template<typename List>
+Result run(std::size_t n, std::uint64_t& checksum) {
+    const std::size_t SCANS = 20u;
+    const std::size_t READS = 2000u;
+    Result result;
+    std::size_t before = structures::slab_counters().bytes;
+    List list;
+    result.fill_ns = seconds([&] {
+        for (std::size_t i = 0u; i < n; i++) {
+            list.push_back(static_cast<int>(i));
+        }
+    }) * 1e9 / n;
+    result.bytes =
+        static_cast<double>(structures::slab_counters().bytes - before) / n;
+    // procura um valor ausente: percorre a lista inteira
+    result.scan_ns = seconds([&] {
+        for (std::size_t i = 0u; i < SCANS; i++) {
+            checksum += list.find(-1);
+        }
+    }) * 1e9 / (SCANS * n);
+    result.at_ns = seconds([&] {
+        for (std::size_t i = 0u; i < READS; i++) {
+            checksum += list.at(i * 7919u % n);
+        }
+    }) * 1e9 / READS;
+    return result;
+}
+
+void print(const char* name, const Result& result) {
+    std::printf("%-12s %12.1f %12.2f %12.2f %12.0f\n", name, result.bytes,
+                result.fill_ns, result.scan_ns, result.at_ns);
+}
+
+}  // namespace
+
+int main() {
+    const std::size_t N = 1000000u;
+    std::uint64_t checksum = 0u;
+
+    std::printf("%zu ints\n", N);
+    std::printf("%-12s %12s %12s %12s %12s\n", "", "bytes/elem",
+                "push_back ns", "find ns/elem", "at ns");
+    print("desenrolada",
+          run<structures::UnrolledLinkedList<int>>(N, checksum));
+    print("encadeada", run<structures::LinkedList<int>>(N, checksum));
+    std::printf("checksum %llu\n", static_cast<unsigned long long>(checksum));
+    return 0;
+}
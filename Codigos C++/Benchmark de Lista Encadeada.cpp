@@ -0,0 +1,136 @@
+// Benchmark: LinkedList com ponteiro de cauda (push_back e append em
+// O(1)) contra a lista antiga, que andava da cabeca ate o fim.
+// Compilar: g++ -std=c++17 -O2 "Benchmark de Lista Encadeada.cpp"
+
+#include <chrono>  // std::chrono::steady_clock
+#include <cstdint>  // std::size_t, std::uint64_t
+#include <cstdio>  // std::printf
+#include <utility>  // std::move
+
+#include "linked_list.h"
+
+namespace {
+
+//! lista simples como era antes: so a cabeca, o fim e achado andando
+class WalkingList {
+ public:
+    WalkingList() = default;
+    ~WalkingList() {
+        while (head_ != nullptr) {
+            Node* next = head_->next;
+            delete head_;
+            head_ = next;
+        }
+    }
+    WalkingList(const WalkingList&) = delete;
+    WalkingList& operator=(const WalkingList&) = delete;
+
+    void push_back(std::uint64_t data) {
+        Node* novo = new Node{data, nullptr};
+        if (head_ == nullptr) {
+            head_ = novo;
+            return;
+        }
+        Node* it = head_;
+        while (it->next != nullptr) {
+            it = it->next;
+        }
+        it->next = novo;
+    }
+
+    //! anda ate o fim e liga os nodos de other
+    void append(WalkingList& other) {
+        if (head_ == nullptr) {
+            head_ = other.head_;
+        } else {
+            Node* it = head_;
+            while (it->next != nullptr) {
+                it = it->next;
+            }
+            it->next = other.head_;
+        }
+        other.head_ = nullptr;
+    }
+
+ private:
+    struct Node {
+        std::uint64_t data;
+        Node* next;
+    };
+
+    Node* head_{nullptr};
+};
+
+template<typename F>
+double seconds(F function) {
+    auto start = std::chrono::steady_clock::now();
+    function();
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+//! segundos para n push_back numa lista vazia
+template<typename List>
+double fill(std::size_t n) {
+    return seconds([n] {
+        List list;
+        for (std::size_t i = 0u; i < n; i++) {
+            list.push_back(i);
+        }
+    });
+}
+
+//! segundos para anexar pieces listas de piece elementos numa so
+//! (sem contar a criacao das listas)
+template<typename List, typename Append>
+double concatenate(std::size_t pieces, std::size_t piece, Append append) {
+    List result;
+    List* parts = new List[pieces];
+    for (std::size_t p = 0u; p < pieces; p++) {
+        for (std::size_t i = 0u; i < piece; i++) {
+            parts[p].push_back(i);
+        }
+    }
+    double elapsed = seconds([&] {
+        for (std::size_t p = 0u; p < pieces; p++) {
+            append(result, parts[p]);
+        }
+    });
+    delete[] parts;
+    return elapsed;
+}
+
+}  // namespace
+
+int main() {
+    const std::size_t N = 1000000u;
+    // a lista antiga e quadratica: medida em tamanhos menores
+    const std::size_t SMALL[] = {10000u, 20000u, 40000u};
+
+    using List = structures::LinkedList<std::uint64_t>;
+    std::printf("push_back, ns por elemento\n");
+    std::printf("%-10s %12s %12s\n", "n", "cauda", "andando");
+    for (std::size_t n : SMALL) {
+        std::printf("%-10zu %12.1f %12.1f\n", n, fill<List>(n) * 1e9 / n,
+                    fill<WalkingList>(n) * 1e9 / n);
+    }
+    std::printf("%-10zu %12.1f %12s\n", N, fill<List>(N) * 1e9 / N, "-");
+
+    // 1M elementos chegando em 1000 pedacos de 1000
+    const std::size_t PIECES = 1000u;
+    const std::size_t PIECE = N / PIECES;
+    double t_append = concatenate<List>(PIECES, PIECE,
+                                        [](List& to, List& from) {
+        to.append(std::move(from));
+    });
+    double t_walk = concatenate<WalkingList>(PIECES, PIECE,
+                                             [](WalkingList& to,
+                                                WalkingList& from) {
+        to.append(from);
+    });
+    std::printf("append de %zu pedacos de %zu: cauda %.3f ms, "
+                "andando %.3f ms\n", PIECES, PIECE, t_append * 1e3,
+                t_walk * 1e3);
+    return 0;
+}
@@ -0,0 +1,125 @@
+// Benchmark: LockFreeSkipList contra SkipList protegida por um std::mutex,
+// com misturas de leitura/escrita e 1, 2, 4 e 8 threads.
+// Compilar: g++ -std=c++17 -O2 -pthread
+//           "Benchmark de Lista de Saltos sem Travas.cpp"
+
+#include <atomic>  // std::atomic
+#include <chrono>  // std::chrono::steady_clock
+#include <cstdint>  // std::size_t, std::uint64_t
+#include <cstdio>  // std::printf
+#include <mutex>  // std::mutex, std::lock_guard
+#include <random>  // std::mt19937_64
+#include <thread>  // std::thread
+#include <vector>  // std::vector
+
+#include "lock_free_skip_list.h"
+#include "skip_list.h"
+
+namespace {
+
+const int KEY_RANGE = 100000;
+const std::size_t OPS = 2000000u;  // total, dividido entre as threads
+
+//! SkipList com uma trava global e semantica de conjunto
+class LockedSkipList {
+ public:
+    bool insert(int data) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (list_.contains(data)) {
+            return false;
+        }
+        list_.insert_sorted(data);
+        return true;
+    }
+
+    bool remove(int data) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!list_.contains(data)) {
+            return false;
+        }
+        list_.remove(data);
+        return true;
+    }
+
+    bool contains(int data) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return list_.contains(data);
+    }
+
+ private:
+    mutable std::mutex mutex_;
+    structures::SkipList<int> list_;
+};
+
+template<typename F>
+double seconds(F function) {
+    auto start = std::chrono::steady_clock::now();
+    function();
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+//! milhoes de operacoes por segundo; read_percent leituras e o resto
+//! dividido igualmente entre insercoes e remocoes
+template<typename Set>
+double run(std::size_t threads, unsigned read_percent,
+           std::uint64_t& checksum) {
+    Set set;
+    for (int key = 0; key < KEY_RANGE; key += 2) {
+        set.insert(key);  // metade das chaves presente
+    }
+    std::atomic<bool> go{false};
+    std::atomic<std::uint64_t> hits{0u};
+    std::vector<std::thread> pool;
+    for (std::size_t t = 0u; t < threads; t++) {
+        pool.emplace_back([&, t] {
+            std::mt19937_64 random(t + 1u);
+            std::uint64_t local = 0u;
+            while (!go.load()) {
+                std::this_thread::yield();
+            }
+            for (std::size_t i = 0u; i < OPS / threads; i++) {
+                std::uint64_t r = random();
+                int key = static_cast<int>(r % KEY_RANGE);
+                unsigned op = static_cast<unsigned>((r >> 32) % 100u);
+                if (op < read_percent) {
+                    local += set.contains(key);
+                } else if ((op - read_percent) % 2u == 0u) {
+                    local += set.insert(key);
+                } else {
+                    local += set.remove(key);
+                }
+            }
+            hits += local;
+        });
+    }
+    double elapsed = seconds([&] {
+        go = true;
+        for (std::thread& thread : pool) {
+            thread.join();
+        }
+    });
+    checksum += hits.load();
+    return OPS / elapsed / 1e6;
+}
+
+}  // namespace
+
+int main() {
+    std::uint64_t checksum = 0u;
+    std::printf("%-10s %-8s %16s %16s\n", "leituras", "threads",
+                "trava Mops/s", "sem trava Mops/s");
+    for (unsigned reads : {90u, 50u}) {
+        for (std::size_t threads : {1u, 2u, 4u, 8u}) {
+            double locked = run<LockedSkipList>(threads, reads, checksum);
+            double lock_free =
+                run<structures::LockFreeSkipList<int>>(threads, reads,
+                                                        checksum);
+            std::printf("%-10u %-8zu %16.2f %16.2f\n", reads, threads,
+                        locked, lock_free);
+        }
+    }
+    std::printf("checksum %llu\n", static_cast<unsigned long long>(checksum));
+    return 0;
+}
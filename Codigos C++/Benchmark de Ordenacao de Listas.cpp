@@ -0,0 +1,119 @@
+// Benchmark: sort e merge por religacao de nodos contra o caminho antigo
+// de insert_sorted um a um, na LinkedList e na DoublyLinkedList.
+// Compilar: g++ -std=c++17 -O2 "Benchmark de Ordenacao de Listas.cpp"
+
+#include <chrono>  // std::chrono::steady_clock
+#include <cstdint>  // std::size_t, std::uint64_t
+#include <cstdio>  // std::printf
+#include <random>  // std::mt19937_64
+#include <vector>  // std::vector
+
+#include "doubly_linked_list.h"
+#include "linked_list.h"
+
+namespace {
+
+template<typename F>
+double seconds(F function) {
+    auto start = std::chrono::steady_clock::now();
+    function();
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+std::vector<std::uint64_t> random_values(std::size_t n, std::uint64_t seed) {
+    std::mt19937_64 random(seed);
+    std::vector<std::uint64_t> values(n);
+    for (std::uint64_t& value : values) {
+        value = random();
+    }
+    return values;
+}
+
+//! ms para montar a lista ordenada com insert_sorted
+template<typename List>
+double by_insert(const std::vector<std::uint64_t>& values) {
+    return seconds([&] {
+        List list;
+        for (std::uint64_t value : values) {
+            list.insert_sorted(value);
+        }
+    }) * 1e3;
+}
+
+//! ms para push_back de tudo seguido de sort
+template<typename List>
+double by_sort(const std::vector<std::uint64_t>& values) {
+    List list;
+    for (std::uint64_t value : values) {
+        list.push_back(value);
+    }
+    return seconds([&] { list.sort(); }) * 1e3;
+}
+
+//! ms para juntar duas listas ordenadas: merge ou insert_sorted de cada
+//! elemento da segunda na primeira
+template<typename List>
+void join(const std::vector<std::uint64_t>& a,
+          const std::vector<std::uint64_t>& b, bool insert, double& ms) {
+    List first;
+    List second;
+    for (std::uint64_t value : a) {
+        first.push_back(value);
+    }
+    for (std::uint64_t value : b) {
+        second.push_back(value);
+    }
+    first.sort();
+    second.sort();
+    ms = seconds([&] {
+        if (insert) {
+            while (!second.empty()) {
+                first.insert_sorted(second.pop_front());
+            }
+        } else {
+            first.merge(second);
+        }
+    }) * 1e3;
+}
+
+}  // namespace
+
+int main() {
+    // insert_sorted e quadratico: nao passa de INSERT_LIMIT
+    const std::size_t INSERT_LIMIT = 20000u;
+
+    using Singly = structures::LinkedList<std::uint64_t>;
+    using Doubly = structures::DoublyLinkedList<std::uint64_t>;
+
+    std::printf("montar lista ordenada, ms\n");
+    std::printf("%-10s %16s %16s %16s %16s\n", "n", "simples insert",
+                "simples sort", "dupla insert", "dupla sort");
+    for (std::size_t n : {1000u, 5000u, 20000u, 1000000u}) {
+        std::vector<std::uint64_t> values = random_values(n, n);
+        std::printf("%-10zu ", n);
+        if (n <= INSERT_LIMIT) {
+            std::printf("%16.2f %16.2f %16.2f %16.2f\n",
+                        by_insert<Singly>(values), by_sort<Singly>(values),
+                        by_insert<Doubly>(values), by_sort<Doubly>(values));
+        } else {
+            std::printf("%16s %16.2f %16s %16.2f\n", "-",
+                        by_sort<Singly>(values), "-",
+                        by_sort<Doubly>(values));
+        }
+    }
+
+    const std::size_t HALF = 10000u;
+    std::vector<std::uint64_t> a = random_values(HALF, 1u);
+    std::vector<std::uint64_t> b = random_values(HALF, 2u);
+    double singly_insert, singly_merge, doubly_insert, doubly_merge;
+    join<Singly>(a, b, true, singly_insert);
+    join<Singly>(a, b, false, singly_merge);
+    join<Doubly>(a, b, true, doubly_insert);
+    join<Doubly>(a, b, false, doubly_merge);
+    std::printf("juntar duas de %zu (insert | merge), ms\n", HALF);
+    std::printf("%-10s %16.2f %16.3f %16.2f %16.3f\n", "juntar",
+                singly_insert, singly_merge, doubly_insert, doubly_merge);
+    return 0;
+}
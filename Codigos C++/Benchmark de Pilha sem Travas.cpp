@@ -0,0 +1,199 @@
+// Benchmark: LockFreeStack (Treiber com eliminacao) contra a mesma pilha
+// sem eliminacao e contra ArrayStack protegida por um std::mutex, com
+// pares push/pop em 1, 2, 4 e 8 threads.
+// Compilar: g++ -std=c++17 -O2 -pthread "Benchmark de Pilha sem Travas.cpp"
+
+#include <atomic>  // std::atomic
+#include <chrono>  // std::chrono::steady_clock
+#include <cstdint>  // std::size_t, std::uint32_t, std::uint64_t
+#include <cstdio>  // std::printf
+#include <memory>  // std::unique_ptr
+#include <mutex>  // std::mutex, std::lock_guard
+#include <thread>  // std::thread, std::this_thread::yield
+#include <vector>  // std::vector
+
+#include "array_stack.h"
+#include "lock_free_stack.h"
+
+namespace {
+
+const std::size_t CAPACITY = 1024u;
+const std::size_t PAIRS = 4000000u;  // total, dividido entre as threads
+
+//! ArrayStack com uma trava e a interface limitada da LockFreeStack
+class LockedStack {
+ public:
+    explicit LockedStack(std::size_t max): stack_(max) {}
+
+    bool try_push(std::uint64_t data) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stack_.full()) {
+            return false;
+        }
+        stack_.push(data);
+        return true;
+    }
+
+    bool try_pop(std::uint64_t& data) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stack_.empty()) {
+            return false;
+        }
+        data = stack_.pop();
+        return true;
+    }
+
+ private:
+    std::mutex mutex_;
+    structures::ArrayStack<std::uint64_t> stack_;
+};
+
+//! pilha de Treiber com o mesmo esquema da LockFreeStack (nodos num
+//! vetor fixo, topo com indice + etiqueta), mas sem eliminacao: toda
+//! disputa repete o CAS no topo
+class TreiberStack {
+ public:
+    explicit TreiberStack(std::size_t max): nodes_{new Node[max]} {
+        for (std::size_t i = 0u; i < max; i++) {
+            nodes_[i].next.store(i + 1u < max ?
+                                     static_cast<std::uint32_t>(i + 1u) : NIL,
+                                 std::memory_order_relaxed);
+        }
+        free_.store(0u);
+    }
+
+    bool try_push(std::uint64_t data) {
+        std::uint32_t index = pop_list(free_);
+        if (index == NIL) {
+            return false;
+        }
+        nodes_[index].data = data;
+        push_list(top_, index);
+        return true;
+    }
+
+    bool try_pop(std::uint64_t& data) {
+        std::uint32_t index = pop_list(top_);
+        if (index == NIL) {
+            return false;
+        }
+        data = nodes_[index].data;
+        push_list(free_, index);
+        return true;
+    }
+
+ private:
+    static const std::uint32_t NIL = 0xffffffffu;
+
+    struct Node {
+        std::uint64_t data;
+        std::atomic<std::uint32_t> next;
+    };
+
+    static std::uint64_t pack(std::uint64_t old, std::uint32_t index) {
+        return (((old >> 32) + 1u) << 32) | index;
+    }
+
+    std::uint32_t pop_list(std::atomic<std::uint64_t>& head) {
+        std::uint64_t old = head.load(std::memory_order_acquire);
+        for (;;) {
+            std::uint32_t index = static_cast<std::uint32_t>(old);
+            if (index == NIL) {
+                return NIL;
+            }
+            std::uint32_t next =
+                nodes_[index].next.load(std::memory_order_relaxed);
+            if (head.compare_exchange_weak(old, pack(old, next),
+                                           std::memory_order_acquire)) {
+                return index;
+            }
+        }
+    }
+
+    void push_list(std::atomic<std::uint64_t>& head, std::uint32_t index) {
+        std::uint64_t old = head.load(std::memory_order_relaxed);
+        do {
+            nodes_[index].next.store(static_cast<std::uint32_t>(old),
+                                     std::memory_order_relaxed);
+        } while (!head.compare_exchange_weak(old, pack(old, index),
+                                             std::memory_order_release,
+                                             std::memory_order_relaxed));
+    }
+
+    std::unique_ptr<Node[]> nodes_;
+    alignas(64) std::atomic<std::uint64_t> top_{NIL};
+    alignas(64) std::atomic<std::uint64_t> free_{NIL};
+};
+
+template<typename F>
+double seconds(F function) {
+    auto start = std::chrono::steady_clock::now();
+    function();
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+//! milhoes de pares push + pop por segundo; confere a soma
+template<typename Stack>
+double run(std::size_t threads, bool& ok) {
+    Stack stack(CAPACITY);
+    std::atomic<bool> go{false};
+    std::atomic<std::uint64_t> pushed{0u};
+    std::atomic<std::uint64_t> popped{0u};
+    std::vector<std::thread> pool;
+    for (std::size_t t = 0u; t < threads; t++) {
+        pool.emplace_back([&, t] {
+            std::uint64_t in = 0u;
+            std::uint64_t out = 0u;
+            std::uint64_t data;
+            while (!go.load()) {
+                std::this_thread::yield();
+            }
+            for (std::size_t i = 0u; i < PAIRS / threads; i++) {
+                std::uint64_t value = t * PAIRS + i;
+                while (!stack.try_push(value)) {
+                    std::this_thread::yield();
+                }
+                in += value;
+                // um pop pode achar a pilha vazia se outro levou o item
+                while (!stack.try_pop(data)) {
+                    std::this_thread::yield();
+                }
+                out += data;
+            }
+            pushed += in;
+            popped += out;
+        });
+    }
+    double elapsed = seconds([&] {
+        go = true;
+        for (std::thread& thread : pool) {
+            thread.join();
+        }
+    });
+    ok = ok && pushed.load() == popped.load();
+    return PAIRS / elapsed / 1e6;
+}
+
+}  // namespace
+
+int main() {
+    bool ok = true;
+    std::printf("%zu pares push/pop, Mpares/s\n", PAIRS);
+    std::printf("%-8s %10s %16s %16s\n", "threads", "trava",
+                "sem eliminacao", "com eliminacao");
+    for (std::size_t threads : {1u, 2u, 4u, 8u}) {
+        double locked = run<LockedStack>(threads, ok);
+        double treiber = run<TreiberStack>(threads, ok);
+        double eliminating =
+            run<structures::LockFreeStack<std::uint64_t>>(threads, ok);
+        std::printf("%-8zu %10.2f %16.2f %16.2f\n", threads, locked, treiber,
+                    eliminating);
+    }
+    if (!ok) {
+        std::printf("soma errada\n");
+        return 1;
+    }
+    return 0;
+}
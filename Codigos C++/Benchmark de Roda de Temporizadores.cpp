@@ -0,0 +1,175 @@
+// Benchmark: TimerWheel contra um heap binario de expiracoes (agendar,
+// cancelar metade e expirar o resto com milhoes de temporizadores), e
+// DoublyCircularList::rotate contra pop_front + push_back num rodizio.
+// Compilar: g++ -std=c++17 -O2 "Benchmark de Roda de Temporizadores.cpp"
+
+#include <chrono>  // std::chrono::steady_clock
+#include <cstdint>  // std::size_t, std::uint64_t
+#include <cstdio>  // std::printf
+#include <functional>  // std::greater
+#include <memory>  // std::unique_ptr
+#include <queue>  // std::priority_queue
+#include <random>  // std::mt19937_64
+#include <utility>  // std::pair
+#include <vector>  // std::vector
+
+#include "doubly_circular_list.h"
+#include "timer_wheel.h"
+
+namespace {
+
+template<typename F>
+double seconds(F function) {
+    auto start = std::chrono::steady_clock::now();
+    function();
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+//! fila de temporizadores classica: heap de (expira, id); cancelar so
+//! marca o id, e a entrada e descartada quando chega ao topo
+class HeapTimers {
+ public:
+    explicit HeapTimers(std::size_t timers): armed_(timers, false) {}
+
+    void schedule(std::size_t id, std::uint64_t delay) {
+        armed_[id] = true;
+        heap_.emplace(now_ + delay, id);
+    }
+
+    bool cancel(std::size_t id) {
+        bool was = armed_[id];
+        armed_[id] = false;
+        return was;
+    }
+
+    std::size_t advance() {
+        now_++;
+        std::size_t fired = 0u;
+        while (!heap_.empty() && heap_.top().first <= now_) {
+            std::size_t id = heap_.top().second;
+            heap_.pop();
+            if (armed_[id]) {
+                armed_[id] = false;
+                fired++;
+            }
+        }
+        return fired;
+    }
+
+    bool empty() const {
+        return heap_.empty();
+    }
+
+ private:
+    using Entry = std::pair<std::uint64_t, std::size_t>;
+
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>>
+        heap_;
+    std::vector<bool> armed_;
+    std::uint64_t now_{0u};
+};
+
+}  // namespace
+
+int main() {
+    const std::size_t TIMERS = 2000000u;
+    const std::uint64_t MAX_DELAY = 100000u;  // ticks
+    std::uint64_t checksum = 0u;
+
+    std::mt19937_64 random(42u);
+    std::vector<std::uint64_t> delays(TIMERS);
+    for (std::uint64_t& delay : delays) {
+        delay = 1u + random() % MAX_DELAY;
+    }
+
+    std::size_t wheel_fired = 0u;
+    std::unique_ptr<structures::Timer[]> timers(
+        new structures::Timer[TIMERS]);
+    for (std::size_t i = 0u; i < TIMERS; i++) {
+        timers[i].callback([&wheel_fired] { wheel_fired++; });
+    }
+    double w_schedule, w_cancel, w_expire;
+    {
+        structures::TimerWheel wheel;
+        w_schedule = seconds([&] {
+            for (std::size_t i = 0u; i < TIMERS; i++) {
+                wheel.schedule(timers[i], delays[i]);
+            }
+        });
+        w_cancel = seconds([&] {
+            for (std::size_t i = 0u; i < TIMERS; i += 2u) {
+                checksum += wheel.cancel(timers[i]);
+            }
+        });
+        w_expire = seconds([&] {
+            while (!wheel.empty()) {
+                wheel.advance();
+            }
+        });
+    }
+
+    std::size_t heap_fired = 0u;
+    double h_schedule, h_cancel, h_expire;
+    {
+        HeapTimers heap(TIMERS);
+        h_schedule = seconds([&] {
+            for (std::size_t i = 0u; i < TIMERS; i++) {
+                heap.schedule(i, delays[i]);
+            }
+        });
+        h_cancel = seconds([&] {
+            for (std::size_t i = 0u; i < TIMERS; i += 2u) {
+                checksum += heap.cancel(i);
+            }
+        });
+        h_expire = seconds([&] {
+            while (!heap.empty()) {
+                heap_fired += heap.advance();
+            }
+        });
+    }
+    if (wheel_fired != heap_fired || wheel_fired != TIMERS / 2u) {
+        std::printf("expiracoes erradas: %zu %zu\n", wheel_fired,
+                    heap_fired);
+        return 1;
+    }
+
+    std::printf("%zu temporizadores, atrasos de 1 a %llu ticks\n", TIMERS,
+                static_cast<unsigned long long>(MAX_DELAY));
+    std::printf("%-22s %10s %10s\n", "ns por temporizador", "roda", "heap");
+    std::printf("%-22s %10.1f %10.1f\n", "schedule",
+                w_schedule * 1e9 / TIMERS, h_schedule * 1e9 / TIMERS);
+    std::printf("%-22s %10.1f %10.1f\n", "cancel (metade)",
+                w_cancel * 2e9 / TIMERS, h_cancel * 2e9 / TIMERS);
+    std::printf("%-22s %10.1f %10.1f\n", "expirar (outra metade)",
+                w_expire * 2e9 / TIMERS, h_expire * 2e9 / TIMERS);
+
+    // rodizio: cada passo passa a vez para o proximo elemento
+    const std::size_t RING = 1000u;
+    const std::size_t STEPS = 20000000u;
+    structures::DoublyCircularList<std::uint64_t> rotated;
+    structures::DoublyCircularList<std::uint64_t> requeued;
+    for (std::size_t i = 0u; i < RING; i++) {
+        rotated.push_back(i);
+        requeued.push_back(i);
+    }
+    double t_rotate = seconds([&] {
+        for (std::size_t i = 0u; i < STEPS; i++) {
+            checksum += rotated.at(0u);
+            rotated.rotate();
+        }
+    });
+    double t_requeue = seconds([&] {
+        for (std::size_t i = 0u; i < STEPS; i++) {
+            checksum += requeued.at(0u);
+            requeued.push_back(requeued.pop_front());
+        }
+    });
+    std::printf("rodizio de %zu: rotate %.2f ns/passo, pop_front + "
+                "push_back %.2f ns/passo\n", RING, t_rotate * 1e9 / STEPS,
+                t_requeue * 1e9 / STEPS);
+    std::printf("checksum %llu\n", static_cast<unsigned long long>(checksum));
+    return 0;
+}
@@ -0,0 +1,112 @@
+// Benchmark: escalabilidade do TaskScheduler (deques de roubo de trabalho)
+// com fib recursivo e quicksort fork-join, de 1 ate N threads.
+// Compilar: g++ -std=c++17 -O2 -pthread "Benchmark de Roubo de Trabalho.cpp"
+
+#include <algorithm>  // std::partition, std::sort, std::is_sorted
+#include <chrono>  // std::chrono::steady_clock
+#include <cstddef>  // std::ptrdiff_t
+#include <cstdint>  // std::size_t, std::uint64_t
+#include <cstdio>  // std::printf
+#include <random>  // std::mt19937_64
+#include <thread>  // std::thread::hardware_concurrency
+#include <vector>  // std::vector
+
+#include "work_stealing.h"
+
+namespace {
+
+template<typename F>
+double seconds(F function) {
+    auto start = std::chrono::steady_clock::now();
+    function();
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+std::uint64_t fib_serial(unsigned n) {
+    return n < 2u ? n : fib_serial(n - 1u) + fib_serial(n - 2u);
+}
+
+//! abaixo de CUTOFF o custo da tarefa passaria o do trabalho
+std::uint64_t fib(structures::TaskScheduler& scheduler, unsigned n) {
+    const unsigned CUTOFF = 20u;
+    if (n < CUTOFF) {
+        return fib_serial(n);
+    }
+    std::uint64_t a = 0u;
+    structures::TaskGroup group(scheduler);
+    group.run([&] { a = fib(scheduler, n - 1u); });
+    std::uint64_t b = fib(scheduler, n - 2u);
+    group.wait();
+    return a + b;
+}
+
+void quicksort(structures::TaskScheduler& scheduler, int* first, int* last) {
+    const std::ptrdiff_t CUTOFF = 4096;
+    if (last - first < CUTOFF) {
+        std::sort(first, last);
+        return;
+    }
+    int pivot = first[(last - first) / 2];
+    int* middle1 = std::partition(first, last,
+                                  [pivot](int x) { return x < pivot; });
+    int* middle2 = std::partition(middle1, last,
+                                  [pivot](int x) { return !(pivot < x); });
+    structures::TaskGroup group(scheduler);
+    group.run([&] { quicksort(scheduler, first, middle1); });
+    quicksort(scheduler, middle2, last);
+    group.wait();
+}
+
+}  // namespace
+
+int main() {
+    const unsigned FIB_N = 38u;
+    const std::size_t SORT_N = 8000000u;
+
+    std::vector<int> input(SORT_N);
+    std::mt19937_64 random(42u);
+    for (int& x : input) {
+        x = static_cast<int>(random());
+    }
+
+    std::size_t max_threads = std::thread::hardware_concurrency();
+    if (max_threads == 0u) {
+        max_threads = 1u;
+    }
+    double fib_base = 0.0;
+    double sort_base = 0.0;
+    std::printf("%-8s %10s %8s %10s %8s\n", "threads", "fib s", "speedup",
+                "sort s", "speedup");
+    // potencias de dois e, por ultimo, todos os nucleos
+    std::vector<std::size_t> counts;
+    for (std::size_t workers = 1u; workers < max_threads; workers *= 2u) {
+        counts.push_back(workers);
+    }
+    counts.push_back(max_threads);
+    for (std::size_t workers : counts) {
+        structures::TaskScheduler scheduler(workers);
+        std::uint64_t result = 0u;
+        double t_fib = seconds([&] { result = fib(scheduler, FIB_N); });
+        if (result != fib_serial(FIB_N)) {
+            std::printf("fib errado\n");
+            return 1;
+        }
+        std::vector<int> data = input;
+        double t_sort = seconds([&] {
+            quicksort(scheduler, data.data(), data.data() + data.size());
+        });
+        if (!std::is_sorted(data.begin(), data.end())) {
+            std::printf("quicksort errado\n");
+            return 1;
+        }
+        if (workers == 1u) {
+            fib_base = t_fib;
+            sort_base = t_sort;
+        }
+        std::printf("%-8zu %10.3f %8.2f %10.3f %8.2f\n", workers, t_fib,
+                    fib_base / t_fib, t_sort, sort_base / t_sort);
+    }
+    return 0;
+}
@@ -1,27 +1,54 @@
 #ifndef STRUCTURES_ARRAY_QUEUE_H
 #define STRUCTURES_ARRAY_QUEUE_H
 
+#include <algorithm>  // std::move, std::copy_n
 #include <cstdint>  // std::size_t
+#include <iterator>  // std::advance
+#include <memory>  // std::allocator, std::allocator_traits
+#include <memory_resource>  // std::pmr::polymorphic_allocator
 #include <stdexcept>  // C++ Exceptions
+#include <utility>  // std::move
 
 namespace structures {
 
-template<typename T>
+template<typename T, typename Allocator = std::allocator<T>>
 //! classe ArrayQueue
 class ArrayQueue {
  public:
+    //! ate dois trechos contiguos com os elementos, na ordem da fila
+    struct Spans {
+        T* first;
+        std::size_t first_size;
+        T* second;
+        std::size_t second_size;
+    };
+
     //! construtor padrao
-    ArrayQueue();
+    explicit ArrayQueue(const Allocator& alloc = Allocator());
     //! construtor com parametro
-    explicit ArrayQueue(std::size_t max);
+    explicit ArrayQueue(std::size_t max, const Allocator& alloc = Allocator());
     //! destrutor padrao
     ~ArrayQueue();
     //! metodo enfileirar
     void enqueue(const T& data);
     //! metodo desenfileirar
     T dequeue();
+    //! metodo enfileira n elementos a partir de first
+    template<typename ForwardIt>
+    void enqueue_bulk(ForwardIt first, std::size_t n);
+    //! metodo desenfileira ate max elementos em out, retorna quantos
+    template<typename OutputIt>
+    std::size_t dequeue_bulk(OutputIt out, std::size_t max);
+    //! metodo expoe os elementos sem copiar (validos ate a proxima escrita)
+    Spans peek_spans();
+    //! metodo descarta os n primeiros (apos processar via peek_spans)
+    void discard(std::size_t n);
+    //! metodo retorna o primeiro
+    T& front();
     //! metodo retorna o ultimo
     T& back();
+    //! metodo garante capacidade para pelo menos n elementos
+    void reserve(std::size_t n);
     //! metodo limpa a fila
     void clear();
     //! metodo retorna tamanho atual
@@ -32,97 +59,249 @@ class ArrayQueue {
     bool empty();
     //! metodo verifica se esta cheio
     bool full();
+    //! metodo retorna o alocador
+    Allocator get_allocator() const;
 
  private:
+    using Traits = std::allocator_traits<Allocator>;
+
+    //! aloca e constroi o vetor pelo alocador
+    T* allocate_contents(std::size_t n);
+    //! destroi e devolve o vetor ao alocador
+    void deallocate_contents(T* p, std::size_t n);
+    //! realoca para nova capacidade (potencia de 2), linearizando a fila
+    void grow(std::size_t new_max);
+    //! menor potencia de 2 maior ou igual a n; out_of_range se nao
+    //! houver uma que caiba em std::size_t
+    static std::size_t round_capacity(std::size_t n);
+
+    Allocator alloc_;
     T* contents;
     std::size_t size_;
-    std::size_t max_size_;
-    int begin_;  // indice do inicio (para fila circular)
-    int end_;  // indice do fim (para fila circular)
-    static const auto DEFAULT_SIZE = 10u;
+    std::size_t max_size_;  // sempre potencia de 2
+    std::size_t begin_;  // indice do inicio (para fila circular)
+    static const auto DEFAULT_SIZE = 16u;
 };
 
-}  // namespace structures
+namespace pmr {
 
+//! ArrayQueue alocando de um std::pmr::memory_resource
+template<typename T>
+using ArrayQueue =
+    structures::ArrayQueue<T, std::pmr::polymorphic_allocator<T>>;
 
-#endif
+}  // namespace pmr
 
+}  // namespace structures
+
+template<typename T, typename Allocator>
+structures::ArrayQueue<T, Allocator>::ArrayQueue(const Allocator& alloc):
+    ArrayQueue(DEFAULT_SIZE, alloc)
+{}
 
-template<typename T>
-structures::ArrayQueue<T>::ArrayQueue() {
-    max_size_ = DEFAULT_SIZE;
-    contents = new T[max_size_];
 
+template<typename T, typename Allocator>
+structures::ArrayQueue<T, Allocator>::ArrayQueue(std::size_t max,
+                                                 const Allocator& alloc):
+    alloc_{alloc} {
+    max_size_ = round_capacity(max);
+    contents = allocate_contents(max_size_);
     size_ = 0u;
     begin_ = 0u;
-    end_ = -1u;
 }
 
 
-template<typename T>
-structures::ArrayQueue<T>::ArrayQueue(std::size_t max) {
-    max_size_ = max;
-    contents = new T[max_size_];
-    size_ = 0u;
-    begin_ = 0u;
-    end_ = -1u;
+template<typename T, typename Allocator>
+structures::ArrayQueue<T, Allocator>::~ArrayQueue() {
+    deallocate_contents(contents, max_size_);
 }
 
+template<typename T, typename Allocator>
+T* structures::ArrayQueue<T, Allocator>::allocate_contents(std::size_t n) {
+    T* p = Traits::allocate(alloc_, n);
+    std::size_t i = 0u;
+    try {
+        for (; i < n; i++) {
+            Traits::construct(alloc_, p + i);
+        }
+    } catch (...) {
+        while (i > 0u) {
+            Traits::destroy(alloc_, p + --i);
+        }
+        Traits::deallocate(alloc_, p, n);
+        throw;
+    }
+    return p;
+}
 
-template<typename T>
-structures::ArrayQueue<T>::~ArrayQueue() {
-    delete [] contents;
+template<typename T, typename Allocator>
+void structures::ArrayQueue<T, Allocator>::deallocate_contents(T* p,
+                                                               std::size_t n) {
+    for (std::size_t i = 0u; i < n; i++) {
+        Traits::destroy(alloc_, p + i);
+    }
+    Traits::deallocate(alloc_, p, n);
 }
 
-template<typename T>
-void structures::ArrayQueue<T>::enqueue(const T& data) {
+template<typename T, typename Allocator>
+void structures::ArrayQueue<T, Allocator>::grow(std::size_t new_max) {
+    T* novo = allocate_contents(new_max);
+    // no maximo dois trechos contiguos: [begin_, fim) e [0, resto)
+    std::size_t first = max_size_ - begin_;
+    if (first > size_) {
+        first = size_;
+    }
+    try {
+        std::move(contents + begin_, contents + begin_ + first, novo);
+        std::move(contents, contents + (size_ - first), novo + first);
+    } catch (...) {
+        deallocate_contents(novo, new_max);
+        throw;
+    }
+    deallocate_contents(contents, max_size_);
+    contents = novo;
+    max_size_ = new_max;
+    begin_ = 0u;
+}
+
+template<typename T, typename Allocator>
+std::size_t structures::ArrayQueue<T, Allocator>::round_capacity(
+    std::size_t n) {
+    const std::size_t LARGEST = ~(~std::size_t{0u} >> 1);
+    if (n > LARGEST) {
+        throw std::out_of_range("Queue capacity too large");
+    }
+    std::size_t capacity = 1u;
+    while (capacity < n) {
+        capacity <<= 1;
+    }
+    return capacity;
+}
+
+template<typename T, typename Allocator>
+void structures::ArrayQueue<T, Allocator>::enqueue(const T& data) {
     if (full()) {
-        throw std::out_of_range("Pilha cheia!");
-    } else {
-        end_ = (end_ + 1u) % max_size_;
-        contents[end_] = data;
+        // data pode ser um elemento desta fila: copia antes de crescer
+        T copy(data);
+        grow(max_size_ << 1);
+        contents[(begin_ + size_) & (max_size_ - 1u)] = std::move(copy);
         size_++;
+        return;
     }
+    contents[(begin_ + size_) & (max_size_ - 1u)] = data;
+    size_++;
 }
-template<typename T>
-T structures::ArrayQueue<T>::dequeue() {
+template<typename T, typename Allocator>
+T structures::ArrayQueue<T, Allocator>::dequeue() {
     if (empty()) {
         throw std::out_of_range("Pilha vazia!");
     }
     T data = contents[begin_];
-    begin_ = (begin_ + 1) % max_size_;
+    begin_ = (begin_ + 1u) & (max_size_ - 1u);
     size_--;
     return data;
 }
-template<typename T>
-T& structures::ArrayQueue<T>::back() {
+template<typename T, typename Allocator>
+template<typename ForwardIt>
+void structures::ArrayQueue<T, Allocator>::enqueue_bulk(ForwardIt first,
+                                                        std::size_t n) {
+    reserve(size_ + n);
+    std::size_t end = (begin_ + size_) & (max_size_ - 1u);
+    std::size_t before_wrap = max_size_ - end;
+    if (before_wrap > n) {
+        before_wrap = n;
+    }
+    std::copy_n(first, before_wrap, contents + end);
+    std::advance(first, before_wrap);
+    std::copy_n(first, n - before_wrap, contents);
+    size_ += n;
+}
+
+template<typename T, typename Allocator>
+template<typename OutputIt>
+std::size_t structures::ArrayQueue<T, Allocator>::dequeue_bulk(
+    OutputIt out, std::size_t max) {
+    std::size_t count = max < size_ ? max : size_;
+    std::size_t before_wrap = max_size_ - begin_;
+    if (before_wrap > count) {
+        before_wrap = count;
+    }
+    out = std::move(contents + begin_, contents + begin_ + before_wrap, out);
+    std::move(contents, contents + (count - before_wrap), out);
+    begin_ = (begin_ + count) & (max_size_ - 1u);
+    size_ -= count;
+    return count;
+}
+
+template<typename T, typename Allocator>
+typename structures::ArrayQueue<T, Allocator>::Spans
+structures::ArrayQueue<T, Allocator>::peek_spans() {
+    std::size_t before_wrap = max_size_ - begin_;
+    if (before_wrap > size_) {
+        before_wrap = size_;
+    }
+    return Spans{contents + begin_, before_wrap,
+                 contents, size_ - before_wrap};
+}
+
+template<typename T, typename Allocator>
+void structures::ArrayQueue<T, Allocator>::discard(std::size_t n) {
+    if (n > size_) {
+        throw std::out_of_range("Queue is empty");
+    }
+    begin_ = (begin_ + n) & (max_size_ - 1u);
+    size_ -= n;
+}
+
+template<typename T, typename Allocator>
+T& structures::ArrayQueue<T, Allocator>::front() {
     if (empty()) {
         throw std::out_of_range("Queue is empty");
     }
-    return contents[end_];
+    return contents[begin_];
+}
+template<typename T, typename Allocator>
+T& structures::ArrayQueue<T, Allocator>::back() {
+    if (empty()) {
+        throw std::out_of_range("Queue is empty");
+    }
+    return contents[(begin_ + size_ - 1u) & (max_size_ - 1u)];
 }
 
-template<typename T>
-void structures::ArrayQueue<T>::clear() {
+template<typename T, typename Allocator>
+void structures::ArrayQueue<T, Allocator>::reserve(std::size_t n) {
+    if (n > max_size_) {
+        grow(round_capacity(n));
+    }
+}
+
+template<typename T, typename Allocator>
+void structures::ArrayQueue<T, Allocator>::clear() {
     size_ = 0u;
     begin_ = 0u;
-    end_ = -1u;
 }
 
-template<typename T>
-std::size_t structures::ArrayQueue<T>::size() {
+template<typename T, typename Allocator>
+std::size_t structures::ArrayQueue<T, Allocator>::size() {
     return size_;
 }
 
-template<typename T>
-std::size_t structures::ArrayQueue<T>::max_size() {
+template<typename T, typename Allocator>
+std::size_t structures::ArrayQueue<T, Allocator>::max_size() {
     return max_size_;
 }
-template<typename T>
-bool structures::ArrayQueue<T>::empty() {
+template<typename T, typename Allocator>
+bool structures::ArrayQueue<T, Allocator>::empty() {
     return (size_ == 0u);
 }
-template<typename T>
-bool structures::ArrayQueue<T>::full() {
+template<typename T, typename Allocator>
+bool structures::ArrayQueue<T, Allocator>::full() {
     return size_ == max_size_;
 }
+
+template<typename T, typename Allocator>
+Allocator structures::ArrayQueue<T, Allocator>::get_allocator() const {
+    return alloc_;
+}
+
+#endif
@@ -2,18 +2,20 @@
 #define STRUCTURES_ARRAY_STACK_H
 
 #include <cstdint>  // std::size_t
+#include <memory>  // std::allocator, std::allocator_traits
+#include <memory_resource>  // std::pmr::polymorphic_allocator
 #include <stdexcept>  // C++ exceptions
 
 namespace structures {
 
-template<typename T>
+template<typename T, typename Allocator = std::allocator<T>>
 //! CLASSE PILHA
 class ArrayStack {
  public:
     //! construtor simples
-    ArrayStack();
+    explicit ArrayStack(const Allocator& alloc = Allocator());
     //! construtor com parametro tamanho
-    explicit ArrayStack(std::size_t max);
+    explicit ArrayStack(std::size_t max, const Allocator& alloc = Allocator());
     //! destrutor
     ~ArrayStack();
     //! metodo empilha
@@ -22,18 +24,29 @@ class ArrayStack {
     T pop();
     //! metodo retorna o topo
     T& top();
+    const T& top() const;
     //! metodo limpa pilha
     void clear();
     //! metodo retorna tamanho
-    std::size_t size();
+    std::size_t size() const;
     //! metodo retorna capacidade maxima
-    std::size_t max_size();
+    std::size_t max_size() const;
     //! verifica se esta vazia
-    bool empty();
+    bool empty() const;
     //! verifica se esta cheia
-    bool full();
+    bool full() const;
+    //! retorna o alocador
+    Allocator get_allocator() const;
 
  private:
+    using Traits = std::allocator_traits<Allocator>;
+
+    //! aloca e constroi o vetor pelo alocador
+    T* allocate_contents(std::size_t n);
+    //! destroi e devolve o vetor ao alocador
+    void deallocate_contents(T* p, std::size_t n);
+
+    Allocator alloc_;
     T* contents;
     int top_;
     std::size_t max_size_;
@@ -41,33 +54,69 @@ class ArrayStack {
     static const auto DEFAULT_SIZE = 10u;
 };
 
-}  // namespace structures
+namespace pmr {
 
-#endif
+//! ArrayStack alocando de um std::pmr::memory_resource
+template<typename T>
+using ArrayStack =
+    structures::ArrayStack<T, std::pmr::polymorphic_allocator<T>>;
 
+}  // namespace pmr
 
-template<typename T>
-structures::ArrayStack<T>::ArrayStack() {
+}  // namespace structures
+
+template<typename T, typename Allocator>
+structures::ArrayStack<T, Allocator>::ArrayStack(const Allocator& alloc):
+    alloc_{alloc} {
     max_size_ = DEFAULT_SIZE;
-    contents = new T[max_size_];
+    contents = allocate_contents(max_size_);
     top_ = -1;
 }
 
-template<typename T>
-structures::ArrayStack<T>::ArrayStack(std::size_t max) {
+template<typename T, typename Allocator>
+structures::ArrayStack<T, Allocator>::ArrayStack(std::size_t max,
+                                                 const Allocator& alloc):
+    alloc_{alloc} {
     // COLOQUE SEU CODIGO AQUI...
-    max_size_ = DEFAULT_SIZE;
-    contents = new T[max_size_];
+    max_size_ = max;
+    contents = allocate_contents(max_size_);
     top_ = -1;
 }
 
-template<typename T>
-structures::ArrayStack<T>::~ArrayStack() {
-    delete [] contents;
+template<typename T, typename Allocator>
+structures::ArrayStack<T, Allocator>::~ArrayStack() {
+    deallocate_contents(contents, max_size_);
 }
 
-template<typename T>
-void structures::ArrayStack<T>::push(const T& data) {
+template<typename T, typename Allocator>
+T* structures::ArrayStack<T, Allocator>::allocate_contents(std::size_t n) {
+    T* p = Traits::allocate(alloc_, n);
+    std::size_t i = 0u;
+    try {
+        for (; i < n; i++) {
+            Traits::construct(alloc_, p + i);
+        }
+    } catch (...) {
+        while (i > 0u) {
+            Traits::destroy(alloc_, p + --i);
+        }
+        Traits::deallocate(alloc_, p, n);
+        throw;
+    }
+    return p;
+}
+
+template<typename T, typename Allocator>
+void structures::ArrayStack<T, Allocator>::deallocate_contents(T* p,
+                                                               std::size_t n) {
+    for (std::size_t i = 0u; i < n; i++) {
+        Traits::destroy(alloc_, p + i);
+    }
+    Traits::deallocate(alloc_, p, n);
+}
+
+template<typename T, typename Allocator>
+void structures::ArrayStack<T, Allocator>::push(const T& data) {
     if (full()) {
         throw std::out_of_range("pilha cheia");
     } else {
@@ -77,8 +126,8 @@ void structures::ArrayStack<T>::push(const T& data) {
     }
 }
 
-template<typename T>
-T structures::ArrayStack<T>::pop() {
+template<typename T, typename Allocator>
+T structures::ArrayStack<T, Allocator>::pop() {
     // COLOQUE SEU CODIGO AQUI...
     if (empty())
         throw std::out_of_range("pilha vazia");
@@ -88,34 +137,41 @@ T structures::ArrayStack<T>::pop() {
     return aux;
 }
 
-template<typename T>
-T& structures::ArrayStack<T>::top() {
+template<typename T, typename Allocator>
+T& structures::ArrayStack<T, Allocator>::top() {
     // COLOQUE SEU CODIGO AQUI...
     if (empty())
         throw std::out_of_range("pilha vazia");
     return contents[top_];
 }
 
-template<typename T>
-void structures::ArrayStack<T>::clear() {
+template<typename T, typename Allocator>
+const T& structures::ArrayStack<T, Allocator>::top() const {
+    if (empty())
+        throw std::out_of_range("pilha vazia");
+    return contents[top_];
+}
+
+template<typename T, typename Allocator>
+void structures::ArrayStack<T, Allocator>::clear() {
     // COLOQUE SEU CODIGO AQUI...
     top_ = -1;
 }
 
-template<typename T>
-std::size_t structures::ArrayStack<T>::size() {
+template<typename T, typename Allocator>
+std::size_t structures::ArrayStack<T, Allocator>::size() const {
     // COLOQUE SEU CODIGO AQUI...
     return top_ + 1;
 }
 
-template<typename T>
-std::size_t structures::ArrayStack<T>::max_size() {
+template<typename T, typename Allocator>
+std::size_t structures::ArrayStack<T, Allocator>::max_size() const {
     // COLOQUE SEU CODIGO AQUI...
     return max_size_;
 }
 
-template<typename T>
-bool structures::ArrayStack<T>::empty() {
+template<typename T, typename Allocator>
+bool structures::ArrayStack<T, Allocator>::empty() const {
     // COLOQUE SEU CODIGO AQUI...
     if (top_ == -1) {
         return true;
@@ -124,9 +180,15 @@ bool structures::ArrayStack<T>::empty() {
     }
 }
 
-template<typename T>
-bool structures::ArrayStack<T>::full() {
+template<typename T, typename Allocator>
+bool structures::ArrayStack<T, Allocator>::full() const {
     // COLOQUE SEU CODIGO AQUI...
     return top_ == static_cast<int>(max_size_ - 1);
 }
 
+template<typename T, typename Allocator>
+Allocator structures::ArrayStack<T, Allocator>::get_allocator() const {
+    return alloc_;
+}
+
+#endif
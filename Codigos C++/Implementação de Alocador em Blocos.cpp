@@ -0,0 +1,287 @@
+#ifndef STRUCTURES_SLAB_ALLOCATOR_H
+#define STRUCTURES_SLAB_ALLOCATOR_H
+
+#include <cstdint>  // std::size_t
+#include <memory>  // std::allocator
+#include <mutex>  // std::mutex, std::lock_guard
+
+namespace structures {
+
+//! contadores do alocador em blocos na thread atual (todos os tipos)
+struct SlabCounters {
+    std::size_t allocations{0u};  // nodos entregues
+    std::size_t deallocations{0u};  // nodos devolvidos
+    std::size_t chunks{0u};  // blocos pedidos ao sistema (mallocs)
+    std::size_t bytes{0u};  // bytes somados desses blocos
+};
+
+//! contadores da thread atual; em regime, chunks nao deve mais crescer
+inline SlabCounters& slab_counters() {
+    thread_local SlabCounters counters;
+    return counters;
+}
+
+namespace detail {
+
+template<typename T>
+//! lista livre por thread para objetos do tipo T, alimentada por blocos
+//! de tamanho crescente; nada volta ao sistema, so para a lista livre
+class Slab {
+ public:
+    //! retira um objeto da lista livre da thread
+    static T* allocate();
+    //! coloca o objeto na lista livre da thread (pode ser outra thread)
+    static void deallocate(T* p);
+    //! encadeia p na frente de first, para um deallocate_chain
+    static void link(T* p, T* first);
+    //! devolve de uma vez a cadeia first..last (n objetos) montada por link
+    static void deallocate_chain(T* first, T* last, std::size_t n);
+
+ private:
+    union Slot {
+        Slot* next;
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    //! estado da thread; trivialmente destrutivel, entao continua valido
+    //! ate o fim da thread, mesmo depois do Guard
+    struct Local {
+        Slot* free;
+        Slot* chunks;  // encadeados pela primeira posicao de cada bloco
+        std::size_t chunk_size;
+    };
+
+    //! ao fim da thread, entrega blocos e lista livre ao deposito
+    struct Guard {
+        ~Guard();
+    };
+
+    //! sobras de threads encerradas, reaproveitadas pelas proximas
+    struct Depot {
+        std::mutex mutex;
+        Slot* free{nullptr};
+        Slot* chunks{nullptr};
+    };
+
+    static const std::size_t FIRST_CHUNK = 32u;
+    static const std::size_t MAX_CHUNK = 4096u;
+
+    static Local& local();
+    static Depot& depot();
+    //! registra o Guard da thread
+    static void enlist();
+    //! reabastece a lista livre (deposito ou bloco novo)
+    static void refill(Local& local);
+    //! ultimo elemento de uma lista encadeada por next
+    static Slot* last(Slot* list);
+};
+
+}  // namespace detail
+
+template<typename T>
+//! alocador sem estado que serve nodos isolados a partir do Slab<T>
+//! da thread; pedidos de mais de um objeto vao para std::allocator
+class SlabAllocator {
+ public:
+    using value_type = T;
+
+    SlabAllocator() noexcept = default;
+
+    template<typename U>
+    SlabAllocator(const SlabAllocator<U>&) noexcept {}  // NOLINT
+
+    T* allocate(std::size_t n) {
+        if (n == 1u) {
+            return detail::Slab<T>::allocate();
+        }
+        return std::allocator<T>().allocate(n);
+    }
+
+    void deallocate(T* p, std::size_t n) noexcept {
+        if (n == 1u) {
+            detail::Slab<T>::deallocate(p);
+        } else {
+            std::allocator<T>().deallocate(p, n);
+        }
+    }
+};
+
+template<typename Allocator>
+//! junta nodos ja destruidos e os devolve ao sair de escopo; no caso
+//! geral e um deallocate por nodo
+class DeallocationBatch {
+ public:
+    using pointer = typename std::allocator_traits<Allocator>::pointer;
+
+    explicit DeallocationBatch(Allocator& alloc): alloc_(alloc) {}
+    DeallocationBatch(const DeallocationBatch&) = delete;
+    DeallocationBatch& operator=(const DeallocationBatch&) = delete;
+
+    void add(pointer p) {
+        std::allocator_traits<Allocator>::deallocate(alloc_, p, 1u);
+    }
+
+ private:
+    Allocator& alloc_;
+};
+
+template<typename T>
+//! com SlabAllocator os nodos sao encadeados pelo proprio espaco e a
+//! cadeia inteira entra na lista livre numa unica operacao
+class DeallocationBatch<SlabAllocator<T>> {
+ public:
+    using pointer = T*;
+
+    explicit DeallocationBatch(SlabAllocator<T>&) {}
+    DeallocationBatch(const DeallocationBatch&) = delete;
+    DeallocationBatch& operator=(const DeallocationBatch&) = delete;
+    ~DeallocationBatch() {
+        if (first_ != nullptr) {
+            detail::Slab<T>::deallocate_chain(first_, last_, count_);
+        }
+    }
+
+    void add(T* p) {
+        detail::Slab<T>::link(p, first_);
+        if (last_ == nullptr) {
+            last_ = p;
+        }
+        first_ = p;
+        count_++;
+    }
+
+ private:
+    T* first_{nullptr};
+    T* last_{nullptr};
+    std::size_t count_{0u};
+};
+
+template<typename T, typename U>
+bool operator==(const SlabAllocator<T>&, const SlabAllocator<U>&) noexcept {
+    return true;
+}
+
+template<typename T, typename U>
+bool operator!=(const SlabAllocator<T>&, const SlabAllocator<U>&) noexcept {
+    return false;
+}
+
+}  // namespace structures
+
+template<typename T>
+typename structures::detail::Slab<T>::Local&
+structures::detail::Slab<T>::local() {
+    thread_local Local local{nullptr, nullptr, FIRST_CHUNK};
+    return local;
+}
+
+template<typename T>
+typename structures::detail::Slab<T>::Depot&
+structures::detail::Slab<T>::depot() {
+    // nunca destruido: listas estaticas ainda podem devolver nodos na saida
+    static Depot* depot = new Depot;
+    return *depot;
+}
+
+template<typename T>
+typename structures::detail::Slab<T>::Slot*
+structures::detail::Slab<T>::last(Slot* list) {
+    while (list->next != nullptr) {
+        list = list->next;
+    }
+    return list;
+}
+
+template<typename T>
+structures::detail::Slab<T>::Guard::~Guard() {
+    Local& local = Slab<T>::local();
+    Depot& depot = Slab<T>::depot();
+    std::lock_guard<std::mutex> lock(depot.mutex);
+    if (local.free != nullptr) {
+        last(local.free)->next = depot.free;
+        depot.free = local.free;
+        local.free = nullptr;
+    }
+    if (local.chunks != nullptr) {
+        last(local.chunks)->next = depot.chunks;
+        depot.chunks = local.chunks;
+        local.chunks = nullptr;
+    }
+}
+
+template<typename T>
+void structures::detail::Slab<T>::enlist() {
+    thread_local Guard guard;
+    (void) guard;
+}
+
+template<typename T>
+void structures::detail::Slab<T>::refill(Local& local) {
+    enlist();
+    {
+        Depot& depot = Slab<T>::depot();
+        std::lock_guard<std::mutex> lock(depot.mutex);
+        if (depot.free != nullptr) {
+            local.free = depot.free;
+            depot.free = nullptr;
+            return;
+        }
+    }
+    // posicao 0 encadeia o bloco; as demais vao para a lista livre
+    Slot* chunk = new Slot[local.chunk_size];
+    chunk[0].next = local.chunks;
+    local.chunks = chunk;
+    for (std::size_t i = local.chunk_size - 1u; i > 0u; i--) {
+        chunk[i].next = local.free;
+        local.free = chunk + i;
+    }
+    SlabCounters& counters = slab_counters();
+    counters.chunks++;
+    counters.bytes += local.chunk_size * sizeof(Slot);
+    if (local.chunk_size < MAX_CHUNK) {
+        local.chunk_size *= 2u;
+    }
+}
+
+template<typename T>
+T* structures::detail::Slab<T>::allocate() {
+    Local& local = Slab<T>::local();
+    if (local.free == nullptr) {
+        refill(local);
+    }
+    Slot* slot = local.free;
+    local.free = slot->next;
+    slab_counters().allocations++;
+    return reinterpret_cast<T*>(slot->storage);
+}
+
+template<typename T>
+void structures::detail::Slab<T>::deallocate(T* p) {
+    Local& local = Slab<T>::local();
+    if (local.free == nullptr) {
+        enlist();  // thread que so devolve tambem entrega as sobras
+    }
+    Slot* slot = reinterpret_cast<Slot*>(p);
+    slot->next = local.free;
+    local.free = slot;
+    slab_counters().deallocations++;
+}
+
+template<typename T>
+void structures::detail::Slab<T>::link(T* p, T* first) {
+    reinterpret_cast<Slot*>(p)->next = reinterpret_cast<Slot*>(first);
+}
+
+template<typename T>
+void structures::detail::Slab<T>::deallocate_chain(T* first, T* last,
+                                                   std::size_t n) {
+    Local& local = Slab<T>::local();
+    if (local.free == nullptr) {
+        enlist();
+    }
+    reinterpret_cast<Slot*>(last)->next = local.free;
+    local.free = reinterpret_cast<Slot*>(first);
+    slab_counters().deallocations += n;
+}
+
+#endif
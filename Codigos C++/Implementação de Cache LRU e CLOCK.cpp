@@ -0,0 +1,599 @@
+#ifndef STRUCTURES_CACHE_H
+#define STRUCTURES_CACHE_H
+
+#include <cstdint>  // std::size_t, std::uint32_t, std::uint64_t, std::uint8_t
+#include <functional>  // std::hash
+#include <memory>  // std::allocator, std::allocator_traits
+#include <memory_resource>  // std::pmr::polymorphic_allocator
+#include <stdexcept>  // C++ exceptions
+
+#include "intrusive_list.h"
+
+namespace structures {
+
+//! contadores de uma cache desde a criacao (ou do ultimo reset_stats)
+struct CacheStats {
+    std::size_t hits{0u};
+    std::size_t misses{0u};
+    std::size_t evictions{0u};
+
+    double hit_rate() const {
+        std::size_t total = hits + misses;
+        return total == 0u ? 0.0 : static_cast<double>(hits) / total;
+    }
+};
+
+namespace detail {
+
+template<typename Allocator>
+//! indice de enderecamento aberto (sondagem linear) de hash para posicao
+//! no vetor de entradas da cache; remocao por deslocamento para tras, sem
+//! lapides. Carga maxima 1/2, pois o numero de entradas e fixo
+class CacheIndex {
+ public:
+    static const std::uint32_t NONE = UINT32_MAX;
+
+    //! capacity se couber em ids de 32 bits; out_of_range se 0 ou maior
+    static std::size_t validate(std::size_t capacity);
+
+    CacheIndex(std::size_t capacity, const Allocator& alloc);
+    ~CacheIndex();
+    CacheIndex(const CacheIndex&) = delete;
+    CacheIndex& operator=(const CacheIndex&) = delete;
+
+    //! posicao com esse hash para a qual equal(posicao) vale, ou NONE
+    template<typename Equal>
+    std::uint32_t find(std::size_t hash, Equal equal) const;
+    //! registra id (que nao pode estar presente)
+    void insert(std::size_t hash, std::uint32_t id);
+    //! retira id, registrado antes com o mesmo hash
+    void erase(std::size_t hash, std::uint32_t id);
+    void clear();
+
+ private:
+    struct Bucket {
+        std::uint32_t id;
+        std::uint32_t tag;  // 32 bits baixos do hash
+    };
+
+    using BucketAllocator = typename std::allocator_traits<Allocator>::
+        template rebind_alloc<Bucket>;
+    using BucketTraits = std::allocator_traits<BucketAllocator>;
+
+    //! espalha os bits: std::hash de inteiros e a identidade, e chaves
+    //! proximas formariam uma unica corrida longa de sondagem
+    static std::size_t mix(std::size_t hash);
+
+    BucketAllocator alloc_;
+    std::size_t mask_;
+    Bucket* buckets_;
+};
+
+}  // namespace detail
+
+template<typename K, typename V, typename Hash = std::hash<K>,
+         typename Allocator = std::allocator<V>>
+//! cache de capacidade fixa que descarta o menos usado recentemente;
+//! indice por hash e lista intrusiva de recencia: get, put e erase O(1)
+class LruCache {
+ public:
+    explicit LruCache(std::size_t capacity, const Hash& hash = Hash(),
+                      const Allocator& alloc = Allocator());
+    ~LruCache();
+    LruCache(const LruCache&) = delete;
+    LruCache& operator=(const LruCache&) = delete;
+
+    //! valor da chave (nullptr se ausente); marca como o mais recente
+    V* get(const K& key);
+    //! insere ou atualiza; cheia, descarta a menos recente
+    void put(const K& key, const V& value);
+    //! retira a chave; false se ausente
+    bool erase(const K& key);
+    //! consulta sem mexer na recencia nem nos contadores
+    bool contains(const K& key) const;
+    void clear();
+
+    std::size_t size() const;
+    std::size_t capacity() const;
+    bool empty() const;
+
+    const CacheStats& stats() const;
+    void reset_stats();
+
+ private:
+    struct Entry {
+        Entry(const K& key, const V& value):
+            key{key},
+            value{value}
+        {}
+
+        K key;
+        V value;
+        ListHook<Entry> hook;
+    };
+
+    using EntryAllocator = typename std::allocator_traits<Allocator>::
+        template rebind_alloc<Entry>;
+    using EntryTraits = std::allocator_traits<EntryAllocator>;
+    using IdAllocator = typename std::allocator_traits<Allocator>::
+        template rebind_alloc<std::uint32_t>;
+
+    std::uint32_t lookup(const K& key, std::size_t hash) const;
+
+    Hash hash_;
+    EntryAllocator alloc_;
+    std::size_t capacity_;
+    std::size_t used_{0u};  // posicoes de entries_ ja usadas alguma vez
+    Entry* entries_;
+    std::uint32_t* free_;  // posicoes liberadas por erase
+    std::size_t free_count_{0u};
+    detail::CacheIndex<Allocator> index_;
+    IntrusiveList<Entry, &Entry::hook> recency_;  // mais recente na frente
+    CacheStats stats_;
+};
+
+template<typename K, typename V, typename Hash = std::hash<K>,
+         typename Allocator = std::allocator<V>>
+//! cache de capacidade fixa com descarte CLOCK (segunda chance): um
+//! acerto so liga um bit; o ponteiro gira pelo anel de entradas limpando
+//! bits ate achar uma sem uso recente
+class ClockCache {
+ public:
+    explicit ClockCache(std::size_t capacity, const Hash& hash = Hash(),
+                        const Allocator& alloc = Allocator());
+    ~ClockCache();
+    ClockCache(const ClockCache&) = delete;
+    ClockCache& operator=(const ClockCache&) = delete;
+
+    //! valor da chave (nullptr se ausente); marca como referenciada
+    V* get(const K& key);
+    //! insere ou atualiza; cheia, descarta a proxima nao referenciada
+    void put(const K& key, const V& value);
+    //! retira a chave; false se ausente
+    bool erase(const K& key);
+    //! consulta sem ligar o bit nem mexer nos contadores
+    bool contains(const K& key) const;
+    void clear();
+
+    std::size_t size() const;
+    std::size_t capacity() const;
+    bool empty() const;
+
+    const CacheStats& stats() const;
+    void reset_stats();
+
+ private:
+    struct Entry {
+        K key;
+        V value;
+    };
+
+    //! bits de flags_, separados das entradas: o giro so le bytes
+    static const std::uint8_t LIVE = 1u;
+    static const std::uint8_t REFERENCED = 2u;
+
+    using EntryAllocator = typename std::allocator_traits<Allocator>::
+        template rebind_alloc<Entry>;
+    using EntryTraits = std::allocator_traits<EntryAllocator>;
+    using IdAllocator = typename std::allocator_traits<Allocator>::
+        template rebind_alloc<std::uint32_t>;
+    using FlagAllocator = typename std::allocator_traits<Allocator>::
+        template rebind_alloc<std::uint8_t>;
+
+    std::uint32_t lookup(const K& key, std::size_t hash) const;
+
+    Hash hash_;
+    EntryAllocator alloc_;
+    std::size_t capacity_;
+    std::size_t size_{0u};
+    std::size_t used_{0u};
+    std::size_t hand_{0u};
+    Entry* entries_;
+    std::uint8_t* flags_;
+    std::uint32_t* free_;
+    std::size_t free_count_{0u};
+    detail::CacheIndex<Allocator> index_;
+    CacheStats stats_;
+};
+
+namespace pmr {
+
+template<typename K, typename V, typename Hash = std::hash<K>>
+using LruCache =
+    structures::LruCache<K, V, Hash, std::pmr::polymorphic_allocator<V>>;
+
+template<typename K, typename V, typename Hash = std::hash<K>>
+using ClockCache =
+    structures::ClockCache<K, V, Hash, std::pmr::polymorphic_allocator<V>>;
+
+}  // namespace pmr
+
+}  // namespace structures
+
+template<typename Allocator>
+structures::detail::CacheIndex<Allocator>::CacheIndex(std::size_t capacity,
+                                                      const Allocator& alloc):
+    alloc_{alloc}
+{
+    std::size_t buckets = 2u;
+    while (buckets < validate(capacity) * 2u) {
+        buckets *= 2u;
+    }
+    mask_ = buckets - 1u;
+    buckets_ = BucketTraits::allocate(alloc_, buckets);
+    clear();
+}
+
+template<typename Allocator>
+std::size_t structures::detail::CacheIndex<Allocator>::validate(
+    std::size_t capacity) {
+    if (capacity == 0u || capacity >= NONE) {
+        throw std::out_of_range("capacidade invalida");
+    }
+    return capacity;
+}
+
+template<typename Allocator>
+std::size_t structures::detail::CacheIndex<Allocator>::mix(
+    std::size_t hash) {
+    // finalizador de 64 bits do MurmurHash3
+    std::uint64_t h = hash;
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdull;
+    h ^= h >> 33;
+    return static_cast<std::size_t>(h);
+}
+
+template<typename Allocator>
+structures::detail::CacheIndex<Allocator>::~CacheIndex() {
+    BucketTraits::deallocate(alloc_, buckets_, mask_ + 1u);
+}
+
+template<typename Allocator>
+void structures::detail::CacheIndex<Allocator>::clear() {
+    for (std::size_t i = 0u; i <= mask_; i++) {
+        buckets_[i].id = NONE;
+    }
+}
+
+template<typename Allocator>
+template<typename Equal>
+std::uint32_t structures::detail::CacheIndex<Allocator>::find(
+    std::size_t hash, Equal equal) const {
+    hash = mix(hash);
+    std::uint32_t tag = static_cast<std::uint32_t>(hash);
+    for (std::size_t i = hash & mask_; buckets_[i].id != NONE;
+         i = (i + 1u) & mask_) {
+        // o tag descarta quase todas as colisoes sem tocar na entrada
+        if (buckets_[i].tag == tag && equal(buckets_[i].id)) {
+            return buckets_[i].id;
+        }
+    }
+    return NONE;
+}
+
+template<typename Allocator>
+void structures::detail::CacheIndex<Allocator>::insert(std::size_t hash,
+                                                       std::uint32_t id) {
+    hash = mix(hash);
+    std::size_t i = hash & mask_;
+    while (buckets_[i].id != NONE) {
+        i = (i + 1u) & mask_;
+    }
+    buckets_[i].id = id;
+    buckets_[i].tag = static_cast<std::uint32_t>(hash);
+}
+
+template<typename Allocator>
+void structures::detail::CacheIndex<Allocator>::erase(std::size_t hash,
+                                                      std::uint32_t id) {
+    std::size_t hole = mix(hash) & mask_;
+    while (buckets_[hole].id != id) {
+        hole = (hole + 1u) & mask_;
+    }
+    // puxa para o buraco quem ficaria inalcancavel sem ele
+    for (std::size_t i = (hole + 1u) & mask_; buckets_[i].id != NONE;
+         i = (i + 1u) & mask_) {
+        std::size_t home = buckets_[i].tag & mask_;
+        if (((i - home) & mask_) >= ((i - hole) & mask_)) {
+            buckets_[hole] = buckets_[i];
+            hole = i;
+        }
+    }
+    buckets_[hole].id = NONE;
+}
+
+template<typename K, typename V, typename Hash, typename Allocator>
+structures::LruCache<K, V, Hash, Allocator>::LruCache(std::size_t capacity,
+                                                      const Hash& hash,
+                                                      const Allocator& alloc):
+    hash_{hash},
+    alloc_{alloc},
+    capacity_{detail::CacheIndex<Allocator>::validate(capacity)},
+    entries_{nullptr},
+    free_{nullptr},
+    index_{capacity_, alloc}
+{
+    entries_ = EntryTraits::allocate(alloc_, capacity_);
+    try {
+        IdAllocator ids(alloc_);
+        free_ = std::allocator_traits<IdAllocator>::allocate(ids, capacity_);
+    } catch (...) {
+        EntryTraits::deallocate(alloc_, entries_, capacity_);
+        throw;
+    }
+}
+
+template<typename K, typename V, typename Hash, typename Allocator>
+structures::LruCache<K, V, Hash, Allocator>::~LruCache() {
+    clear();
+    IdAllocator ids(alloc_);
+    std::allocator_traits<IdAllocator>::deallocate(ids, free_, capacity_);
+    EntryTraits::deallocate(alloc_, entries_, capacity_);
+}
+
+template<typename K, typename V, typename Hash, typename Allocator>
+std::uint32_t structures::LruCache<K, V, Hash, Allocator>::lookup(
+    const K& key, std::size_t hash) const {
+    return index_.find(hash, [this, &key](std::uint32_t id) {
+        return entries_[id].key == key;
+    });
+}
+
+template<typename K, typename V, typename Hash, typename Allocator>
+V* structures::LruCache<K, V, Hash, Allocator>::get(const K& key) {
+    std::uint32_t id = lookup(key, hash_(key));
+    if (id == detail::CacheIndex<Allocator>::NONE) {
+        stats_.misses++;
+        return nullptr;
+    }
+    stats_.hits++;
+    Entry& entry = entries_[id];
+    recency_.remove(entry);
+    recency_.push_front(entry);
+    return &entry.value;
+}
+
+template<typename K, typename V, typename Hash, typename Allocator>
+void structures::LruCache<K, V, Hash, Allocator>::put(const K& key,
+                                                      const V& value) {
+    std::size_t hash = hash_(key);
+    std::uint32_t id = lookup(key, hash);
+    if (id != detail::CacheIndex<Allocator>::NONE) {
+        Entry& entry = entries_[id];
+        entry.value = value;
+        recency_.remove(entry);
+        recency_.push_front(entry);
+        return;
+    }
+    if (recency_.size() == capacity_) {
+        // reaproveita a entrada da menos recente no lugar
+        Entry& victim = recency_.pop_back();
+        id = static_cast<std::uint32_t>(&victim - entries_);
+        index_.erase(hash_(victim.key), id);
+        victim.key = key;
+        victim.value = value;
+        stats_.evictions++;
+    } else {
+        id = free_count_ > 0u ? free_[--free_count_]
+                              : static_cast<std::uint32_t>(used_++);
+        EntryTraits::construct(alloc_, entries_ + id, key, value);
+    }
+    index_.insert(hash, id);
+    recency_.push_front(entries_[id]);
+}
+
+template<typename K, typename V, typename Hash, typename Allocator>
+bool structures::LruCache<K, V, Hash, Allocator>::erase(const K& key) {
+    std::size_t hash = hash_(key);
+    std::uint32_t id = lookup(key, hash);
+    if (id == detail::CacheIndex<Allocator>::NONE) {
+        return false;
+    }
+    index_.erase(hash, id);
+    recency_.remove(entries_[id]);
+    EntryTraits::destroy(alloc_, entries_ + id);
+    free_[free_count_++] = id;
+    return true;
+}
+
+template<typename K, typename V, typename Hash, typename Allocator>
+bool structures::LruCache<K, V, Hash, Allocator>::contains(
+    const K& key) const {
+    return lookup(key, hash_(key)) != detail::CacheIndex<Allocator>::NONE;
+}
+
+template<typename K, typename V, typename Hash, typename Allocator>
+void structures::LruCache<K, V, Hash, Allocator>::clear() {
+    while (!recency_.empty()) {
+        EntryTraits::destroy(alloc_, &recency_.pop_front());
+    }
+    index_.clear();
+    used_ = 0u;
+    free_count_ = 0u;
+}
+
+template<typename K, typename V, typename Hash, typename Allocator>
+std::size_t structures::LruCache<K, V, Hash, Allocator>::size() const {
+    return recency_.size();
+}
+
+template<typename K, typename V, typename Hash, typename Allocator>
+std::size_t structures::LruCache<K, V, Hash, Allocator>::capacity() const {
+    return capacity_;
+}
+
+template<typename K, typename V, typename Hash, typename Allocator>
+bool structures::LruCache<K, V, Hash, Allocator>::empty() const {
+    return recency_.empty();
+}
+
+template<typename K, typename V, typename Hash, typename Allocator>
+const structures::CacheStats&
+structures::LruCache<K, V, Hash, Allocator>::stats() const {
+    return stats_;
+}
+
+template<typename K, typename V, typename Hash, typename Allocator>
+void structures::LruCache<K, V, Hash, Allocator>::reset_stats() {
+    stats_ = CacheStats();
+}
+
+template<typename K, typename V, typename Hash, typename Allocator>
+structures::ClockCache<K, V, Hash, Allocator>::ClockCache(
+    std::size_t capacity, const Hash& hash, const Allocator& alloc):
+    hash_{hash},
+    alloc_{alloc},
+    capacity_{detail::CacheIndex<Allocator>::validate(capacity)},
+    entries_{nullptr},
+    flags_{nullptr},
+    free_{nullptr},
+    index_{capacity_, alloc}
+{
+    entries_ = EntryTraits::allocate(alloc_, capacity_);
+    FlagAllocator flags(alloc_);
+    IdAllocator ids(alloc_);
+    try {
+        flags_ = std::allocator_traits<FlagAllocator>::allocate(flags,
+                                                                 capacity_);
+        free_ = std::allocator_traits<IdAllocator>::allocate(ids, capacity_);
+    } catch (...) {
+        if (flags_ != nullptr) {
+            std::allocator_traits<FlagAllocator>::deallocate(flags, flags_,
+                                                             capacity_);
+        }
+        EntryTraits::deallocate(alloc_, entries_, capacity_);
+        throw;
+    }
+    for (std::size_t i = 0u; i < capacity_; i++) {
+        flags_[i] = 0u;
+    }
+}
+
+template<typename K, typename V, typename Hash, typename Allocator>
+structures::ClockCache<K, V, Hash, Allocator>::~ClockCache() {
+    clear();
+    FlagAllocator flags(alloc_);
+    IdAllocator ids(alloc_);
+    std::allocator_traits<IdAllocator>::deallocate(ids, free_, capacity_);
+    std::allocator_traits<FlagAllocator>::deallocate(flags, flags_,
+                                                     capacity_);
+    EntryTraits::deallocate(alloc_, entries_, capacity_);
+}
+
+template<typename K, typename V, typename Hash, typename Allocator>
+std::uint32_t structures::ClockCache<K, V, Hash, Allocator>::lookup(
+    const K& key, std::size_t hash) const {
+    return index_.find(hash, [this, &key](std::uint32_t id) {
+        return entries_[id].key == key;
+    });
+}
+
+template<typename K, typename V, typename Hash, typename Allocator>
+V* structures::ClockCache<K, V, Hash, Allocator>::get(const K& key) {
+    std::uint32_t id = lookup(key, hash_(key));
+    if (id == detail::CacheIndex<Allocator>::NONE) {
+        stats_.misses++;
+        return nullptr;
+    }
+    stats_.hits++;
+    flags_[id] |= REFERENCED;
+    return &entries_[id].value;
+}
+
+template<typename K, typename V, typename Hash, typename Allocator>
+void structures::ClockCache<K, V, Hash, Allocator>::put(const K& key,
+                                                        const V& value) {
+    std::size_t hash = hash_(key);
+    std::uint32_t id = lookup(key, hash);
+    if (id != detail::CacheIndex<Allocator>::NONE) {
+        entries_[id].value = value;
+        flags_[id] |= REFERENCED;
+        return;
+    }
+    if (size_ == capacity_) {
+        // cheia: todas vivas; no pior caso da uma volta limpando os bits
+        while (flags_[hand_] & REFERENCED) {
+            flags_[hand_] &= ~REFERENCED;
+            hand_ = hand_ + 1u == capacity_ ? 0u : hand_ + 1u;
+        }
+        id = static_cast<std::uint32_t>(hand_);
+        hand_ = hand_ + 1u == capacity_ ? 0u : hand_ + 1u;
+        Entry& victim = entries_[id];
+        index_.erase(hash_(victim.key), id);
+        victim.key = key;
+        victim.value = value;
+        stats_.evictions++;
+    } else {
+        id = free_count_ > 0u ? free_[--free_count_]
+                              : static_cast<std::uint32_t>(used_++);
+        EntryTraits::construct(alloc_, entries_ + id, Entry{key, value});
+        size_++;
+    }
+    flags_[id] = LIVE;
+    index_.insert(hash, id);
+}
+
+template<typename K, typename V, typename Hash, typename Allocator>
+bool structures::ClockCache<K, V, Hash, Allocator>::erase(const K& key) {
+    std::size_t hash = hash_(key);
+    std::uint32_t id = lookup(key, hash);
+    if (id == detail::CacheIndex<Allocator>::NONE) {
+        return false;
+    }
+    index_.erase(hash, id);
+    EntryTraits::destroy(alloc_, entries_ + id);
+    flags_[id] = 0u;
+    free_[free_count_++] = id;
+    size_--;
+    return true;
+}
+
+template<typename K, typename V, typename Hash, typename Allocator>
+bool structures::ClockCache<K, V, Hash, Allocator>::contains(
+    const K& key) const {
+    return lookup(key, hash_(key)) != detail::CacheIndex<Allocator>::NONE;
+}
+
+template<typename K, typename V, typename Hash, typename Allocator>
+void structures::ClockCache<K, V, Hash, Allocator>::clear() {
+    for (std::size_t i = 0u; i < used_; i++) {
+        if (flags_[i] & LIVE) {
+            EntryTraits::destroy(alloc_, entries_ + i);
+            flags_[i] = 0u;
+        }
+    }
+    index_.clear();
+    size_ = 0u;
+    used_ = 0u;
+    hand_ = 0u;
+    free_count_ = 0u;
+}
+
+template<typename K, typename V, typename Hash, typename Allocator>
+std::size_t structures::ClockCache<K, V, Hash, Allocator>::size() const {
+    return size_;
+}
+
+template<typename K, typename V, typename Hash, typename Allocator>
+std::size_t structures::ClockCache<K, V, Hash, Allocator>::capacity() const {
+    return capacity_;
+}
+
+template<typename K, typename V, typename Hash, typename Allocator>
+bool structures::ClockCache<K, V, Hash, Allocator>::empty() const {
+    return size_ == 0u;
+}
+
+template<typename K, typename V, typename Hash, typename Allocator>
+const structures::CacheStats&
+structures::ClockCache<K, V, Hash, Allocator>::stats() const {
+    return stats_;
+}
+
+template<typename K, typename V, typename Hash, typename Allocator>
+void structures::ClockCache<K, V, Hash, Allocator>::reset_stats() {
+    stats_ = CacheStats();
+}
+
+#endif
@@ -0,0 +1,512 @@
+#ifndef STRUCTURES_WORK_STEALING_H
+#define STRUCTURES_WORK_STEALING_H
+
+#include <atomic>  // std::atomic
+#include <condition_variable>  // std::condition_variable
+#include <cstdint>  // std::int64_t, std::uint64_t
+#include <exception>  // std::exception_ptr
+#include <functional>  // std::function
+#include <memory>  // std::allocator, std::allocator_traits, std::unique_ptr
+#include <memory_resource>  // std::pmr::polymorphic_allocator
+#include <mutex>  // std::mutex
+#include <thread>  // std::thread
+#include <type_traits>  // std::is_trivially_copyable
+#include <utility>  // std::move
+#include <vector>  // std::vector
+
+#include "array_queue.h"
+
+namespace structures {
+
+template<typename T, typename Allocator = std::allocator<T>>
+//! deque de Chase-Lev: o dono empilha e desempilha embaixo (bottom),
+//! ladroes roubam em cima (top) sem travas; o vetor circular cresce
+class WorkStealingDeque {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "use ponteiros ou tipos copiaveis por bytes");
+
+ public:
+    //! construtor com capacidade inicial (arredondada para potencia de 2)
+    explicit WorkStealingDeque(std::size_t max = DEFAULT_SIZE,
+                               const Allocator& alloc = Allocator());
+    //! destrutor (libera tambem os vetores antigos)
+    ~WorkStealingDeque();
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+    //! dono: insere embaixo
+    void push(const T& data);
+    //! dono: retira de baixo; false se vazio
+    bool pop(T& data);
+    //! qualquer thread: retira de cima; false se vazio ou se perdeu a disputa
+    bool steal(T& data);
+    //! tamanho aproximado
+    std::size_t size() const;
+    //! verifica se vazio (aproximado)
+    bool empty() const;
+
+ private:
+    struct Array {
+        T get(std::int64_t i) const {
+            return contents[i & (capacity - 1)].load(std::memory_order_relaxed);
+        }
+
+        void put(std::int64_t i, const T& data) {
+            contents[i & (capacity - 1)].store(data, std::memory_order_relaxed);
+        }
+
+        std::int64_t capacity;
+        std::atomic<T>* contents;
+        Array* retired{nullptr};  // vetor anterior, liberado no destrutor
+    };
+
+    using SlotAllocator = typename std::allocator_traits<Allocator>::
+        template rebind_alloc<std::atomic<T>>;
+    using SlotTraits = std::allocator_traits<SlotAllocator>;
+    using ArrayAllocator = typename std::allocator_traits<Allocator>::
+        template rebind_alloc<Array>;
+    using ArrayTraits = std::allocator_traits<ArrayAllocator>;
+
+    static const auto DEFAULT_SIZE = 64u;
+
+    //! aloca um vetor vazio com capacity posicoes
+    Array* allocate_array(std::int64_t capacity);
+    //! devolve o vetor ao alocador
+    void deallocate_array(Array* array);
+    //! dono: copia [top, bottom) para um vetor com o dobro do tamanho
+    Array* grow(Array* old, std::int64_t bottom, std::int64_t top);
+
+    SlotAllocator slot_alloc_;
+    ArrayAllocator array_alloc_;
+    alignas(64) std::atomic<std::int64_t> top_{0};
+    alignas(64) std::atomic<std::int64_t> bottom_{0};
+    std::atomic<Array*> array_;
+};
+
+namespace pmr {
+
+//! WorkStealingDeque alocando de um std::pmr::memory_resource
+template<typename T>
+using WorkStealingDeque =
+    structures::WorkStealingDeque<T, std::pmr::polymorphic_allocator<T>>;
+
+}  // namespace pmr
+
+class TaskScheduler;
+
+//! grupo de tarefas fork-join: run dispara, wait espera todas
+class TaskGroup {
+ public:
+    explicit TaskGroup(TaskScheduler& scheduler);
+    //! espera as tarefas pendentes
+    ~TaskGroup();
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+    //! dispara task no escalonador
+    void run(std::function<void()> task);
+    //! executa tarefas ate todas as do grupo terminarem;
+    //! relanca a primeira excecao de uma tarefa do grupo
+    void wait();
+
+ private:
+    TaskScheduler& scheduler_;
+    std::atomic<std::size_t> pending_{0u};
+    std::mutex error_mutex_;
+    std::exception_ptr error_;
+};
+
+//! escalonador com um WorkStealingDeque por thread trabalhadora
+class TaskScheduler {
+ public:
+    //! inicia workers threads (0 = uma por nucleo)
+    explicit TaskScheduler(std::size_t workers = 0u);
+    //! termina as threads; tarefas ainda nao executadas sao descartadas
+    ~TaskScheduler();
+    TaskScheduler(const TaskScheduler&) = delete;
+    TaskScheduler& operator=(const TaskScheduler&) = delete;
+    //! dispara uma tarefa; de dentro de uma tarefa vai para o deque local.
+    //! Uma excecao que escape da tarefa fica guardada para take_error
+    void spawn(std::function<void()> task);
+    //! executa uma tarefa pendente, se houver; false se nao achou
+    bool run_one();
+    //! primeira excecao escapada de uma tarefa de spawn desde a ultima
+    //! chamada (nullptr se nenhuma)
+    std::exception_ptr take_error();
+    //! numero de threads trabalhadoras
+    std::size_t workers() const;
+
+ private:
+    struct Task {
+        std::function<void()> function;
+    };
+
+    struct Worker {
+        WorkStealingDeque<Task*> deque;
+        std::thread thread;
+    };
+
+    static const auto IDLE_SPINS = 64u;
+
+    void worker_loop(std::size_t index);
+    //! indice do worker da thread atual neste escalonador, ou workers()
+    std::size_t current_worker() const;
+    //! tenta pegar tarefa: deque local, fila global, roubo
+    Task* find_task(std::size_t self);
+
+    std::vector<Worker*> workers_;
+    std::mutex mutex_;  // protege injected_ e a espera dos ociosos
+    std::condition_variable wake_;
+    ArrayQueue<Task*> injected_;  // tarefas disparadas de fora
+    std::atomic<std::size_t> injected_size_{0u};
+    std::atomic<std::size_t> sleeping_{0u};
+    std::uint64_t generation_{0u};  // spawns vistos por ociosos; mutex_
+    std::atomic<bool> stop_{false};
+    std::mutex error_mutex_;
+    std::exception_ptr error_;
+};
+
+}  // namespace structures
+
+template<typename T, typename Allocator>
+structures::WorkStealingDeque<T, Allocator>::WorkStealingDeque(
+    std::size_t max, const Allocator& alloc):
+    slot_alloc_{alloc},
+    array_alloc_{alloc} {
+    std::int64_t capacity = 1;
+    while (capacity < static_cast<std::int64_t>(max)) {
+        capacity <<= 1;
+    }
+    array_.store(allocate_array(capacity), std::memory_order_relaxed);
+}
+
+template<typename T, typename Allocator>
+structures::WorkStealingDeque<T, Allocator>::~WorkStealingDeque() {
+    Array* array = array_.load(std::memory_order_relaxed);
+    while (array != nullptr) {
+        Array* retired = array->retired;
+        deallocate_array(array);
+        array = retired;
+    }
+}
+
+template<typename T, typename Allocator>
+typename structures::WorkStealingDeque<T, Allocator>::Array*
+structures::WorkStealingDeque<T, Allocator>::allocate_array(
+    std::int64_t capacity) {
+    std::size_t n = static_cast<std::size_t>(capacity);
+    std::atomic<T>* contents = SlotTraits::allocate(slot_alloc_, n);
+    for (std::size_t i = 0u; i < n; i++) {
+        SlotTraits::construct(slot_alloc_, contents + i);
+    }
+    Array* array;
+    try {
+        array = ArrayTraits::allocate(array_alloc_, 1u);
+    } catch (...) {
+        SlotTraits::deallocate(slot_alloc_, contents, n);
+        throw;
+    }
+    ArrayTraits::construct(array_alloc_, array,
+                           Array{capacity, contents, nullptr});
+    return array;
+}
+
+template<typename T, typename Allocator>
+void structures::WorkStealingDeque<T, Allocator>::deallocate_array(
+    Array* array) {
+    std::size_t n = static_cast<std::size_t>(array->capacity);
+    for (std::size_t i = 0u; i < n; i++) {
+        SlotTraits::destroy(slot_alloc_, array->contents + i);
+    }
+    SlotTraits::deallocate(slot_alloc_, array->contents, n);
+    ArrayTraits::destroy(array_alloc_, array);
+    ArrayTraits::deallocate(array_alloc_, array, 1u);
+}
+
+template<typename T, typename Allocator>
+typename structures::WorkStealingDeque<T, Allocator>::Array*
+structures::WorkStealingDeque<T, Allocator>::grow(Array* old,
+                                                  std::int64_t bottom,
+                                                  std::int64_t top) {
+    Array* array = allocate_array(old->capacity * 2);
+    for (std::int64_t i = top; i < bottom; i++) {
+        array->put(i, old->get(i));
+    }
+    // ladroes podem ainda estar lendo o vetor antigo: so libera no fim
+    array->retired = old;
+    return array;
+}
+
+template<typename T, typename Allocator>
+void structures::WorkStealingDeque<T, Allocator>::push(const T& data) {
+    std::int64_t bottom = bottom_.load(std::memory_order_relaxed);
+    std::int64_t top = top_.load(std::memory_order_acquire);
+    Array* array = array_.load(std::memory_order_relaxed);
+    if (bottom - top > array->capacity - 1) {
+        array = grow(array, bottom, top);
+        array_.store(array, std::memory_order_release);
+    }
+    array->put(bottom, data);
+    // publica o elemento para os ladroes (que leem bottom_ com acquire)
+    bottom_.store(bottom + 1, std::memory_order_release);
+}
+
+template<typename T, typename Allocator>
+bool structures::WorkStealingDeque<T, Allocator>::pop(T& data) {
+    std::int64_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+    Array* array = array_.load(std::memory_order_relaxed);
+    bottom_.store(bottom, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    std::int64_t top = top_.load(std::memory_order_relaxed);
+    if (top > bottom) {
+        bottom_.store(bottom + 1, std::memory_order_relaxed);
+        return false;
+    }
+    data = array->get(bottom);
+    if (top == bottom) {
+        // ultimo elemento: disputa com os ladroes pelo top
+        bool won = top_.compare_exchange_strong(top, top + 1,
+                                                std::memory_order_seq_cst,
+                                                std::memory_order_relaxed);
+        bottom_.store(bottom + 1, std::memory_order_relaxed);
+        return won;
+    }
+    return true;
+}
+
+template<typename T, typename Allocator>
+bool structures::WorkStealingDeque<T, Allocator>::steal(T& data) {
+    std::int64_t top = top_.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    std::int64_t bottom = bottom_.load(std::memory_order_acquire);
+    if (top >= bottom) {
+        return false;
+    }
+    Array* array = array_.load(std::memory_order_acquire);
+    T value = array->get(top);
+    if (!top_.compare_exchange_strong(top, top + 1,
+                                      std::memory_order_seq_cst,
+                                      std::memory_order_relaxed)) {
+        return false;
+    }
+    data = value;
+    return true;
+}
+
+template<typename T, typename Allocator>
+std::size_t structures::WorkStealingDeque<T, Allocator>::size() const {
+    std::int64_t bottom = bottom_.load(std::memory_order_relaxed);
+    std::int64_t top = top_.load(std::memory_order_relaxed);
+    return bottom > top ? static_cast<std::size_t>(bottom - top) : 0u;
+}
+
+template<typename T, typename Allocator>
+bool structures::WorkStealingDeque<T, Allocator>::empty() const {
+    return size() == 0u;
+}
+
+inline structures::TaskGroup::TaskGroup(TaskScheduler& scheduler):
+    scheduler_(scheduler)
+{}
+
+inline structures::TaskGroup::~TaskGroup() {
+    while (pending_.load(std::memory_order_acquire) > 0u) {
+        if (!scheduler_.run_one()) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+inline void structures::TaskGroup::run(std::function<void()> task) {
+    pending_.fetch_add(1u, std::memory_order_relaxed);
+    scheduler_.spawn([this, task = std::move(task)] {
+        try {
+            task();
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(error_mutex_);
+            if (!error_) {
+                error_ = std::current_exception();
+            }
+        }
+        pending_.fetch_sub(1u, std::memory_order_release);
+    });
+}
+
+inline void structures::TaskGroup::wait() {
+    // quem espera ajuda a executar, entao fork-join aninhado nao trava
+    while (pending_.load(std::memory_order_acquire) > 0u) {
+        if (!scheduler_.run_one()) {
+            std::this_thread::yield();
+        }
+    }
+    std::lock_guard<std::mutex> lock(error_mutex_);
+    if (error_) {
+        std::exception_ptr error = error_;
+        error_ = nullptr;
+        std::rethrow_exception(error);
+    }
+}
+
+namespace structures {
+namespace detail {
+
+//! escalonador e indice do worker da thread atual
+struct CurrentWorker {
+    const TaskScheduler* scheduler{nullptr};
+    std::size_t index{0u};
+};
+
+inline CurrentWorker& current_worker() {
+    thread_local CurrentWorker current;
+    return current;
+}
+
+}  // namespace detail
+}  // namespace structures
+
+inline structures::TaskScheduler::TaskScheduler(std::size_t workers) {
+    if (workers == 0u) {
+        workers = std::thread::hardware_concurrency();
+        if (workers == 0u) {
+            workers = 1u;
+        }
+    }
+    for (std::size_t i = 0u; i < workers; i++) {
+        workers_.push_back(new Worker);
+    }
+    for (std::size_t i = 0u; i < workers; i++) {
+        workers_[i]->thread = std::thread(&TaskScheduler::worker_loop, this, i);
+    }
+}
+
+inline structures::TaskScheduler::~TaskScheduler() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_.store(true);
+    }
+    wake_.notify_all();
+    for (Worker* worker : workers_) {
+        worker->thread.join();
+    }
+    for (Worker* worker : workers_) {
+        Task* task;
+        while (worker->deque.pop(task)) {
+            delete task;
+        }
+        delete worker;
+    }
+    while (!injected_.empty()) {
+        delete injected_.dequeue();
+    }
+}
+
+inline std::size_t structures::TaskScheduler::workers() const {
+    return workers_.size();
+}
+
+inline std::size_t structures::TaskScheduler::current_worker() const {
+    const detail::CurrentWorker& current = detail::current_worker();
+    return current.scheduler == this ? current.index : workers_.size();
+}
+
+inline void structures::TaskScheduler::spawn(std::function<void()> task) {
+    Task* novo = new Task{std::move(task)};
+    std::size_t self = current_worker();
+    if (self < workers_.size()) {
+        workers_[self]->deque.push(novo);
+    } else {
+        std::lock_guard<std::mutex> lock(mutex_);
+        injected_.enqueue(novo);
+        injected_size_.store(injected_.size(), std::memory_order_release);
+    }
+    // par do fetch_add em worker_loop: ou este load ve o ocioso, ou o
+    // ocioso, ao conferir de novo, ve a tarefa ja empilhada
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (sleeping_.load(std::memory_order_relaxed) > 0u) {
+        // vale para o deque local e para a fila global: o predicado da
+        // espera olha generation_, nao onde a tarefa foi parar
+        std::lock_guard<std::mutex> lock(mutex_);
+        generation_++;
+        wake_.notify_one();
+    }
+}
+
+inline structures::TaskScheduler::Task* structures::TaskScheduler::find_task(
+    std::size_t self) {
+    Task* task;
+    if (self < workers_.size() && workers_[self]->deque.pop(task)) {
+        return task;
+    }
+    if (injected_size_.load(std::memory_order_acquire) > 0u) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!injected_.empty()) {
+            task = injected_.dequeue();
+            injected_size_.store(injected_.size(), std::memory_order_release);
+            return task;
+        }
+    }
+    // rouba a partir de um vizinho, dando a volta em todos
+    std::size_t n = workers_.size();
+    std::size_t start = self < n ? self + 1u : 0u;
+    for (std::size_t i = 0u; i < n; i++) {
+        std::size_t victim = (start + i) % n;
+        if (victim != self && workers_[victim]->deque.steal(task)) {
+            return task;
+        }
+    }
+    return nullptr;
+}
+
+inline bool structures::TaskScheduler::run_one() {
+    Task* task = find_task(current_worker());
+    if (task == nullptr) {
+        return false;
+    }
+    std::unique_ptr<Task> owned(task);
+    try {
+        owned->function();
+    } catch (...) {
+        // nao deixa a excecao derrubar o worker nem escapar para um wait
+        // de TaskGroup que esteja ajudando com uma tarefa alheia
+        std::lock_guard<std::mutex> lock(error_mutex_);
+        if (!error_) {
+            error_ = std::current_exception();
+        }
+    }
+    return true;
+}
+
+inline std::exception_ptr structures::TaskScheduler::take_error() {
+    std::lock_guard<std::mutex> lock(error_mutex_);
+    std::exception_ptr error = error_;
+    error_ = nullptr;
+    return error;
+}
+
+inline void structures::TaskScheduler::worker_loop(std::size_t index) {
+    detail::current_worker() = detail::CurrentWorker{this, index};
+    auto idle = 0u;
+    while (!stop_.load(std::memory_order_acquire)) {
+        if (run_one()) {
+            idle = 0u;
+        } else if (++idle < IDLE_SPINS) {
+            std::this_thread::yield();
+        } else {
+            // sem trabalho por um tempo: anuncia que vai dormir, confere
+            // de novo e so entao dorme ate o proximo spawn
+            std::unique_lock<std::mutex> lock(mutex_);
+            sleeping_.fetch_add(1u, std::memory_order_seq_cst);
+            std::uint64_t seen = generation_;
+            lock.unlock();
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (!run_one()) {
+                lock.lock();
+                wake_.wait(lock, [this, seen] {
+                    return stop_.load() || generation_ != seen;
+                });
+            }
+            sleeping_.fetch_sub(1u, std::memory_order_acq_rel);
+            idle = 0u;
+        }
+    }
+}
+
+#endif
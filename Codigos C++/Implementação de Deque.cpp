@@ -0,0 +1,289 @@
+#ifndef STRUCTURES_DEQUE_H
+#define STRUCTURES_DEQUE_H
+
+#include <algorithm>  // std::move
+#include <cstdint>  // std::size_t
+#include <memory>  // std::allocator, std::allocator_traits
+#include <memory_resource>  // std::pmr::polymorphic_allocator
+#include <stdexcept>  // C++ exceptions
+#include <utility>  // std::move
+
+namespace structures {
+
+template<typename T, typename Allocator = std::allocator<T>>
+//! fila de duas pontas em vetor circular (mesmo esquema da ArrayQueue)
+class Deque {
+ public:
+    //! construtor padrao
+    explicit Deque(const Allocator& alloc = Allocator());
+    //! construtor com capacidade inicial
+    explicit Deque(std::size_t max, const Allocator& alloc = Allocator());
+    //! destrutor
+    ~Deque();
+    Deque(const Deque&) = delete;
+    Deque& operator=(const Deque&) = delete;
+    //! insere no fim
+    void push_back(const T& data);
+    //! insere no inicio
+    void push_front(const T& data);
+    //! retira do fim
+    T pop_back();
+    //! retira do inicio
+    T pop_front();
+    //! primeiro elemento
+    T& front();
+    //! ultimo elemento
+    T& back();
+    //! elemento na posicao index (com verificacao)
+    T& at(std::size_t index);
+    const T& at(std::size_t index) const;
+    //! elemento na posicao index (sem verificacao)
+    T& operator[](std::size_t index);
+    const T& operator[](std::size_t index) const;
+    //! garante capacidade para pelo menos n elementos
+    void reserve(std::size_t n);
+    //! limpa
+    void clear();
+    //! tamanho atual
+    std::size_t size() const;
+    //! capacidade atual
+    std::size_t max_size() const;
+    //! verifica se vazio
+    bool empty() const;
+    //! retorna o alocador
+    Allocator get_allocator() const;
+
+ private:
+    using Traits = std::allocator_traits<Allocator>;
+
+    //! aloca e constroi o vetor pelo alocador
+    T* allocate_contents(std::size_t n);
+    //! destroi e devolve o vetor ao alocador
+    void deallocate_contents(T* p, std::size_t n);
+    //! realoca para nova capacidade (potencia de 2), linearizando
+    void grow(std::size_t new_max);
+    //! indice fisico do elemento logico index
+    std::size_t slot(std::size_t index) const;
+
+    Allocator alloc_;
+    T* contents;
+    std::size_t size_{0u};
+    std::size_t max_size_;  // sempre potencia de 2
+    std::size_t begin_{0u};
+    static const auto DEFAULT_SIZE = 16u;
+};
+
+namespace pmr {
+
+//! Deque alocando de um std::pmr::memory_resource
+template<typename T>
+using Deque = structures::Deque<T, std::pmr::polymorphic_allocator<T>>;
+
+}  // namespace pmr
+
+}  // namespace structures
+
+template<typename T, typename Allocator>
+structures::Deque<T, Allocator>::Deque(const Allocator& alloc):
+    Deque(DEFAULT_SIZE, alloc)
+{}
+
+template<typename T, typename Allocator>
+structures::Deque<T, Allocator>::Deque(std::size_t max,
+                                       const Allocator& alloc):
+    alloc_{alloc} {
+    max_size_ = 1u;
+    while (max_size_ < max) {
+        max_size_ <<= 1;
+    }
+    contents = allocate_contents(max_size_);
+}
+
+template<typename T, typename Allocator>
+structures::Deque<T, Allocator>::~Deque() {
+    deallocate_contents(contents, max_size_);
+}
+
+template<typename T, typename Allocator>
+T* structures::Deque<T, Allocator>::allocate_contents(std::size_t n) {
+    T* p = Traits::allocate(alloc_, n);
+    std::size_t i = 0u;
+    try {
+        for (; i < n; i++) {
+            Traits::construct(alloc_, p + i);
+        }
+    } catch (...) {
+        while (i > 0u) {
+            Traits::destroy(alloc_, p + --i);
+        }
+        Traits::deallocate(alloc_, p, n);
+        throw;
+    }
+    return p;
+}
+
+template<typename T, typename Allocator>
+void structures::Deque<T, Allocator>::deallocate_contents(T* p,
+                                                          std::size_t n) {
+    for (std::size_t i = 0u; i < n; i++) {
+        Traits::destroy(alloc_, p + i);
+    }
+    Traits::deallocate(alloc_, p, n);
+}
+
+template<typename T, typename Allocator>
+void structures::Deque<T, Allocator>::grow(std::size_t new_max) {
+    T* novo = allocate_contents(new_max);
+    // no maximo dois trechos contiguos: [begin_, fim) e [0, resto)
+    std::size_t first = max_size_ - begin_;
+    if (first > size_) {
+        first = size_;
+    }
+    try {
+        std::move(contents + begin_, contents + begin_ + first, novo);
+        std::move(contents, contents + (size_ - first), novo + first);
+    } catch (...) {
+        deallocate_contents(novo, new_max);
+        throw;
+    }
+    deallocate_contents(contents, max_size_);
+    contents = novo;
+    max_size_ = new_max;
+    begin_ = 0u;
+}
+
+template<typename T, typename Allocator>
+std::size_t structures::Deque<T, Allocator>::slot(std::size_t index) const {
+    return (begin_ + index) & (max_size_ - 1u);
+}
+
+template<typename T, typename Allocator>
+void structures::Deque<T, Allocator>::push_back(const T& data) {
+    if (size_ == max_size_) {
+        // data pode ser um elemento deste deque: copia antes de crescer
+        T copy(data);
+        grow(max_size_ << 1);
+        contents[slot(size_)] = std::move(copy);
+        size_++;
+        return;
+    }
+    contents[slot(size_)] = data;
+    size_++;
+}
+
+template<typename T, typename Allocator>
+void structures::Deque<T, Allocator>::push_front(const T& data) {
+    if (size_ == max_size_) {
+        T copy(data);
+        grow(max_size_ << 1);
+        begin_ = (begin_ - 1u) & (max_size_ - 1u);
+        contents[begin_] = std::move(copy);
+        size_++;
+        return;
+    }
+    begin_ = (begin_ - 1u) & (max_size_ - 1u);
+    contents[begin_] = data;
+    size_++;
+}
+
+template<typename T, typename Allocator>
+T structures::Deque<T, Allocator>::pop_back() {
+    if (empty()) {
+        throw std::out_of_range("Deque vazio");
+    }
+    size_--;
+    return std::move(contents[slot(size_)]);
+}
+
+template<typename T, typename Allocator>
+T structures::Deque<T, Allocator>::pop_front() {
+    if (empty()) {
+        throw std::out_of_range("Deque vazio");
+    }
+    T data = std::move(contents[begin_]);
+    begin_ = (begin_ + 1u) & (max_size_ - 1u);
+    size_--;
+    return data;
+}
+
+template<typename T, typename Allocator>
+T& structures::Deque<T, Allocator>::front() {
+    if (empty()) {
+        throw std::out_of_range("Deque vazio");
+    }
+    return contents[begin_];
+}
+
+template<typename T, typename Allocator>
+T& structures::Deque<T, Allocator>::back() {
+    if (empty()) {
+        throw std::out_of_range("Deque vazio");
+    }
+    return contents[slot(size_ - 1u)];
+}
+
+template<typename T, typename Allocator>
+T& structures::Deque<T, Allocator>::at(std::size_t index) {
+    if (index >= size_) {
+        throw std::out_of_range("Posição inválida");
+    }
+    return contents[slot(index)];
+}
+
+template<typename T, typename Allocator>
+const T& structures::Deque<T, Allocator>::at(std::size_t index) const {
+    if (index >= size_) {
+        throw std::out_of_range("Posição inválida");
+    }
+    return contents[slot(index)];
+}
+
+template<typename T, typename Allocator>
+T& structures::Deque<T, Allocator>::operator[](std::size_t index) {
+    return contents[slot(index)];
+}
+
+template<typename T, typename Allocator>
+const T& structures::Deque<T, Allocator>::operator[](
+    std::size_t index) const {
+    return contents[slot(index)];
+}
+
+template<typename T, typename Allocator>
+void structures::Deque<T, Allocator>::reserve(std::size_t n) {
+    if (n > max_size_) {
+        std::size_t new_max = max_size_;
+        while (new_max < n) {
+            new_max <<= 1;
+        }
+        grow(new_max);
+    }
+}
+
+template<typename T, typename Allocator>
+void structures::Deque<T, Allocator>::clear() {
+    size_ = 0u;
+    begin_ = 0u;
+}
+
+template<typename T, typename Allocator>
+std::size_t structures::Deque<T, Allocator>::size() const {
+    return size_;
+}
+
+template<typename T, typename Allocator>
+std::size_t structures::Deque<T, Allocator>::max_size() const {
+    return max_size_;
+}
+
+template<typename T, typename Allocator>
+bool structures::Deque<T, Allocator>::empty() const {
+    return size_ == 0u;
+}
+
+template<typename T, typename Allocator>
+Allocator structures::Deque<T, Allocator>::get_allocator() const {
+    return alloc_;
+}
+
+#endif
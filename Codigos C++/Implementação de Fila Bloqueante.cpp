@@ -0,0 +1,242 @@
+#ifndef STRUCTURES_BLOCKING_QUEUE_H
+#define STRUCTURES_BLOCKING_QUEUE_H
+
+#include <atomic>  // std::atomic
+#include <chrono>  // std::chrono::duration
+#include <condition_variable>  // std::condition_variable
+#include <cstdint>  // std::size_t
+#include <memory>  // std::allocator
+#include <memory_resource>  // std::pmr::polymorphic_allocator
+#include <mutex>  // std::mutex, std::unique_lock
+#include <stdexcept>  // C++ exceptions
+#include <thread>  // std::this_thread::yield
+
+#include "array_queue.h"
+
+namespace structures {
+
+template<typename T, typename Allocator = std::allocator<T>>
+//! fila limitada que bloqueia quem insere (cheia) e quem retira (vazia)
+class BlockingQueue {
+ public:
+    //! construtor com capacidade maxima (out_of_range se 0)
+    explicit BlockingQueue(std::size_t max,
+                           const Allocator& alloc = Allocator());
+    BlockingQueue(const BlockingQueue&) = delete;
+    BlockingQueue& operator=(const BlockingQueue&) = delete;
+    //! enfileira, esperando haver espaco; false se a fila foi fechada
+    bool push(const T& data);
+    //! desenfileira em data, esperando haver elemento;
+    //! false se a fila foi fechada e ja esta vazia
+    bool pop(T& data);
+    //! enfileira sem esperar; false se cheia ou fechada
+    bool try_push(const T& data);
+    //! desenfileira sem esperar; false se vazia
+    bool try_pop(T& data);
+    //! desenfileira esperando no maximo timeout; false se nada chegou
+    template<typename Rep, typename Period>
+    bool try_pop_for(T& data,
+                     const std::chrono::duration<Rep, Period>& timeout);
+    //! fecha a fila: push falha, pop drena o que restou e depois falha
+    void close();
+    //! verifica se foi fechada
+    bool closed() const;
+    //! tamanho atual
+    std::size_t size() const;
+    //! capacidade maxima
+    std::size_t max_size() const;
+    //! verifica se vazia
+    bool empty() const;
+
+ private:
+    //! giros antes de dormir na variavel de condicao
+    static const auto SPIN_LIMIT = 64u;
+
+    //! max se for uma capacidade valida; out_of_range se 0, pois push
+    //! esperaria para sempre
+    static std::size_t validate(std::size_t max);
+
+    //! gira por pouco tempo esperando cond, sem pegar a trava
+    template<typename Predicate>
+    static bool spin_until(Predicate cond);
+    //! retira com a trava pega e acorda um produtor se preciso
+    void take(T& data);
+    //! insere com a trava pega e acorda um consumidor se preciso
+    void put(const T& data);
+
+    std::mutex mutex_;
+    std::condition_variable not_empty_;
+    std::condition_variable not_full_;
+    ArrayQueue<T, Allocator> queue_;
+    std::size_t max_size_;
+    std::atomic<std::size_t> size_{0u};  // copia de queue_.size() para giros
+    std::atomic<bool> closed_{false};
+    std::size_t waiting_consumers_{0u};
+    std::size_t waiting_producers_{0u};
+};
+
+namespace pmr {
+
+//! BlockingQueue alocando de um std::pmr::memory_resource
+template<typename T>
+using BlockingQueue =
+    structures::BlockingQueue<T, std::pmr::polymorphic_allocator<T>>;
+
+}  // namespace pmr
+
+}  // namespace structures
+
+template<typename T, typename Allocator>
+structures::BlockingQueue<T, Allocator>::BlockingQueue(std::size_t max,
+                                                       const Allocator& alloc):
+    queue_(validate(max), alloc),
+    max_size_{max}
+{}
+
+template<typename T, typename Allocator>
+std::size_t structures::BlockingQueue<T, Allocator>::validate(
+    std::size_t max) {
+    if (max == 0u) {
+        throw std::out_of_range("capacidade invalida");
+    }
+    return max;
+}
+
+template<typename T, typename Allocator>
+template<typename Predicate>
+bool structures::BlockingQueue<T, Allocator>::spin_until(Predicate cond) {
+    for (auto i = 0u; i < SPIN_LIMIT; i++) {
+        if (cond()) {
+            return true;
+        }
+        if (i >= SPIN_LIMIT / 2) {
+            std::this_thread::yield();
+        }
+    }
+    return cond();
+}
+
+template<typename T, typename Allocator>
+void structures::BlockingQueue<T, Allocator>::take(T& data) {
+    data = queue_.dequeue();
+    size_.store(queue_.size(), std::memory_order_relaxed);
+    if (waiting_producers_ > 0u) {
+        not_full_.notify_one();
+    }
+}
+
+template<typename T, typename Allocator>
+void structures::BlockingQueue<T, Allocator>::put(const T& data) {
+    queue_.enqueue(data);
+    size_.store(queue_.size(), std::memory_order_relaxed);
+    if (waiting_consumers_ > 0u) {
+        not_empty_.notify_one();
+    }
+}
+
+template<typename T, typename Allocator>
+bool structures::BlockingQueue<T, Allocator>::push(const T& data) {
+    spin_until([this] {
+        return size_.load(std::memory_order_relaxed) < max_size_ ||
+               closed_.load(std::memory_order_relaxed);
+    });
+    std::unique_lock<std::mutex> lock(mutex_);
+    waiting_producers_++;
+    not_full_.wait(lock, [this] {
+        return queue_.size() < max_size_ || closed_.load();
+    });
+    waiting_producers_--;
+    if (closed_.load()) {
+        return false;
+    }
+    put(data);
+    return true;
+}
+
+template<typename T, typename Allocator>
+bool structures::BlockingQueue<T, Allocator>::pop(T& data) {
+    spin_until([this] {
+        return size_.load(std::memory_order_relaxed) > 0u ||
+               closed_.load(std::memory_order_relaxed);
+    });
+    std::unique_lock<std::mutex> lock(mutex_);
+    waiting_consumers_++;
+    not_empty_.wait(lock, [this] {
+        return !queue_.empty() || closed_.load();
+    });
+    waiting_consumers_--;
+    if (queue_.empty()) {
+        return false;
+    }
+    take(data);
+    return true;
+}
+
+template<typename T, typename Allocator>
+bool structures::BlockingQueue<T, Allocator>::try_push(const T& data) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (closed_.load() || queue_.size() >= max_size_) {
+        return false;
+    }
+    put(data);
+    return true;
+}
+
+template<typename T, typename Allocator>
+bool structures::BlockingQueue<T, Allocator>::try_pop(T& data) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (queue_.empty()) {
+        return false;
+    }
+    take(data);
+    return true;
+}
+
+template<typename T, typename Allocator>
+template<typename Rep, typename Period>
+bool structures::BlockingQueue<T, Allocator>::try_pop_for(
+    T& data, const std::chrono::duration<Rep, Period>& timeout) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    waiting_consumers_++;
+    bool ready = not_empty_.wait_for(lock, timeout, [this] {
+        return !queue_.empty() || closed_.load();
+    });
+    waiting_consumers_--;
+    if (!ready || queue_.empty()) {
+        return false;
+    }
+    take(data);
+    return true;
+}
+
+template<typename T, typename Allocator>
+void structures::BlockingQueue<T, Allocator>::close() {
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        closed_.store(true);
+    }
+    not_empty_.notify_all();
+    not_full_.notify_all();
+}
+
+template<typename T, typename Allocator>
+bool structures::BlockingQueue<T, Allocator>::closed() const {
+    return closed_.load();
+}
+
+template<typename T, typename Allocator>
+std::size_t structures::BlockingQueue<T, Allocator>::size() const {
+    return size_.load();
+}
+
+template<typename T, typename Allocator>
+std::size_t structures::BlockingQueue<T, Allocator>::max_size() const {
+    return max_size_;
+}
+
+template<typename T, typename Allocator>
+bool structures::BlockingQueue<T, Allocator>::empty() const {
+    return size() == 0u;
+}
+
+#endif
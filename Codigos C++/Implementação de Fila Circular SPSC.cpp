@@ -0,0 +1,164 @@
+#ifndef STRUCTURES_SPSC_QUEUE_H
+#define STRUCTURES_SPSC_QUEUE_H
+
+#include <atomic>  // std::atomic
+#include <cstdint>  // std::size_t
+#include <memory>  // std::allocator, std::allocator_traits
+#include <memory_resource>  // std::pmr::polymorphic_allocator
+#include <utility>  // std::move
+
+namespace structures {
+
+template<typename T, typename Allocator = std::allocator<T>>
+//! fila circular limitada, um produtor e um consumidor, sem travas
+class SpscQueue {
+ public:
+    //! construtor com capacidade (arredondada para potencia de 2)
+    explicit SpscQueue(std::size_t max, const Allocator& alloc = Allocator());
+    //! destrutor
+    ~SpscQueue();
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+    //! produtor: enfileira, retorna false se cheia
+    bool try_enqueue(const T& data);
+    //! produtor: enfileira movendo, retorna false se cheia
+    bool try_enqueue(T&& data);
+    //! consumidor: desenfileira em data, retorna false se vazia
+    bool try_dequeue(T& data);
+    //! tamanho atual (aproximado se houver operacoes concorrentes)
+    std::size_t size() const;
+    //! capacidade
+    std::size_t max_size() const;
+    //! verifica se vazia (aproximado se houver operacoes concorrentes)
+    bool empty() const;
+
+ private:
+    using Traits = std::allocator_traits<Allocator>;
+
+    static const std::size_t CACHE_LINE = 64u;
+
+    //! produtor: le o proprio indice em tail, false se cheia
+    bool reserve_slot(std::size_t& tail);
+
+    Allocator alloc_;
+    T* contents;
+    std::size_t max_size_;  // sempre potencia de 2
+
+    // lado do consumidor; tail_cache_ e a ultima copia vista de tail_
+    alignas(CACHE_LINE) std::atomic<std::size_t> head_{0u};
+    std::size_t tail_cache_{0u};
+    // lado do produtor; head_cache_ e a ultima copia vista de head_
+    alignas(CACHE_LINE) std::atomic<std::size_t> tail_{0u};
+    std::size_t head_cache_{0u};
+};
+
+namespace pmr {
+
+//! SpscQueue alocando de um std::pmr::memory_resource
+template<typename T>
+using SpscQueue =
+    structures::SpscQueue<T, std::pmr::polymorphic_allocator<T>>;
+
+}  // namespace pmr
+
+}  // namespace structures
+
+template<typename T, typename Allocator>
+structures::SpscQueue<T, Allocator>::SpscQueue(std::size_t max,
+                                               const Allocator& alloc):
+    alloc_{alloc} {
+    max_size_ = 1u;
+    while (max_size_ < max) {
+        max_size_ <<= 1;
+    }
+    contents = Traits::allocate(alloc_, max_size_);
+    std::size_t i = 0u;
+    try {
+        for (; i < max_size_; i++) {
+            Traits::construct(alloc_, contents + i);
+        }
+    } catch (...) {
+        while (i > 0u) {
+            Traits::destroy(alloc_, contents + --i);
+        }
+        Traits::deallocate(alloc_, contents, max_size_);
+        throw;
+    }
+}
+
+template<typename T, typename Allocator>
+structures::SpscQueue<T, Allocator>::~SpscQueue() {
+    for (std::size_t i = 0u; i < max_size_; i++) {
+        Traits::destroy(alloc_, contents + i);
+    }
+    Traits::deallocate(alloc_, contents, max_size_);
+}
+
+template<typename T, typename Allocator>
+bool structures::SpscQueue<T, Allocator>::reserve_slot(std::size_t& tail) {
+    tail = tail_.load(std::memory_order_relaxed);
+    if (tail - head_cache_ == max_size_) {
+        // so le o indice do consumidor quando a copia local diz "cheia"
+        head_cache_ = head_.load(std::memory_order_acquire);
+        if (tail - head_cache_ == max_size_) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template<typename T, typename Allocator>
+bool structures::SpscQueue<T, Allocator>::try_enqueue(const T& data) {
+    std::size_t tail;
+    if (!reserve_slot(tail)) {
+        return false;
+    }
+    contents[tail & (max_size_ - 1u)] = data;
+    tail_.store(tail + 1u, std::memory_order_release);
+    return true;
+}
+
+template<typename T, typename Allocator>
+bool structures::SpscQueue<T, Allocator>::try_enqueue(T&& data) {
+    std::size_t tail;
+    if (!reserve_slot(tail)) {
+        return false;
+    }
+    contents[tail & (max_size_ - 1u)] = std::move(data);
+    tail_.store(tail + 1u, std::memory_order_release);
+    return true;
+}
+
+template<typename T, typename Allocator>
+bool structures::SpscQueue<T, Allocator>::try_dequeue(T& data) {
+    std::size_t head = head_.load(std::memory_order_relaxed);
+    if (head == tail_cache_) {
+        // so le o indice do produtor quando a copia local diz "vazia"
+        tail_cache_ = tail_.load(std::memory_order_acquire);
+        if (head == tail_cache_) {
+            return false;
+        }
+    }
+    data = std::move(contents[head & (max_size_ - 1u)]);
+    head_.store(head + 1u, std::memory_order_release);
+    return true;
+}
+
+template<typename T, typename Allocator>
+std::size_t structures::SpscQueue<T, Allocator>::size() const {
+    std::size_t head = head_.load(std::memory_order_acquire);
+    std::size_t tail = tail_.load(std::memory_order_acquire);
+    return tail > head ? tail - head : 0u;
+}
+
+template<typename T, typename Allocator>
+std::size_t structures::SpscQueue<T, Allocator>::max_size() const {
+    return max_size_;
+}
+
+template<typename T, typename Allocator>
+bool structures::SpscQueue<T, Allocator>::empty() const {
+    return size() == 0u;
+}
+
+#endif
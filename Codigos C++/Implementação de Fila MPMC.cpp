@@ -0,0 +1,260 @@
+#ifndef STRUCTURES_MPMC_QUEUE_H
+#define STRUCTURES_MPMC_QUEUE_H
+
+#include <atomic>  // std::atomic
+#include <cstddef>  // std::ptrdiff_t
+#include <cstdint>  // std::size_t
+#include <memory>  // std::allocator, std::allocator_traits
+#include <memory_resource>  // std::pmr::polymorphic_allocator
+#include <utility>  // std::move
+
+namespace structures {
+
+template<typename T, typename Allocator = std::allocator<T>>
+//! fila circular limitada, varios produtores e consumidores, sem travas
+//! (cada posicao tem um numero de sequencia, como na fila de Vyukov)
+class MpmcQueue {
+ public:
+    //! construtor com capacidade (arredondada para potencia de 2, minimo 2)
+    explicit MpmcQueue(std::size_t max, const Allocator& alloc = Allocator());
+    //! destrutor
+    ~MpmcQueue();
+    MpmcQueue(const MpmcQueue&) = delete;
+    MpmcQueue& operator=(const MpmcQueue&) = delete;
+    //! enfileira, retorna false se cheia
+    bool try_enqueue(const T& data);
+    //! enfileira movendo, retorna false se cheia
+    bool try_enqueue(T&& data);
+    //! desenfileira em data, retorna false se vazia
+    bool try_dequeue(T& data);
+    //! enfileira ate n elementos de first, retorna quantos entraram
+    template<typename InputIt>
+    std::size_t try_enqueue_bulk(InputIt first, std::size_t n);
+    //! desenfileira ate max elementos em out, retorna quantos sairam
+    template<typename OutputIt>
+    std::size_t try_dequeue_bulk(OutputIt out, std::size_t max);
+    //! tamanho atual (aproximado se houver operacoes concorrentes)
+    std::size_t size() const;
+    //! capacidade
+    std::size_t max_size() const;
+    //! verifica se vazia (aproximado se houver operacoes concorrentes)
+    bool empty() const;
+
+ private:
+    struct Cell {
+        std::atomic<std::size_t> sequence;
+        T data;
+    };
+
+    using CellAllocator =
+        typename std::allocator_traits<Allocator>::template rebind_alloc<Cell>;
+    using CellTraits = std::allocator_traits<CellAllocator>;
+
+    static const std::size_t CACHE_LINE = 64u;
+
+    //! reserva ate n posicoes livres seguidas a partir de pos; retorna quantas
+    std::size_t claim_enqueue(std::size_t n, std::size_t& pos);
+    //! reserva ate n posicoes ocupadas a partir de pos; retorna quantas
+    std::size_t claim_dequeue(std::size_t n, std::size_t& pos);
+
+    CellAllocator alloc_;
+    Cell* cells;
+    std::size_t max_size_;  // sempre potencia de 2
+
+    alignas(CACHE_LINE) std::atomic<std::size_t> enqueue_pos_{0u};
+    alignas(CACHE_LINE) std::atomic<std::size_t> dequeue_pos_{0u};
+};
+
+namespace pmr {
+
+//! MpmcQueue alocando de um std::pmr::memory_resource
+template<typename T>
+using MpmcQueue =
+    structures::MpmcQueue<T, std::pmr::polymorphic_allocator<T>>;
+
+}  // namespace pmr
+
+}  // namespace structures
+
+template<typename T, typename Allocator>
+structures::MpmcQueue<T, Allocator>::MpmcQueue(std::size_t max,
+                                               const Allocator& alloc):
+    alloc_{alloc} {
+    max_size_ = 2u;
+    while (max_size_ < max) {
+        max_size_ <<= 1;
+    }
+    cells = CellTraits::allocate(alloc_, max_size_);
+    std::size_t i = 0u;
+    try {
+        for (; i < max_size_; i++) {
+            CellTraits::construct(alloc_, cells + i);
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    } catch (...) {
+        while (i > 0u) {
+            CellTraits::destroy(alloc_, cells + --i);
+        }
+        CellTraits::deallocate(alloc_, cells, max_size_);
+        throw;
+    }
+}
+
+template<typename T, typename Allocator>
+structures::MpmcQueue<T, Allocator>::~MpmcQueue() {
+    for (std::size_t i = 0u; i < max_size_; i++) {
+        CellTraits::destroy(alloc_, cells + i);
+    }
+    CellTraits::deallocate(alloc_, cells, max_size_);
+}
+
+template<typename T, typename Allocator>
+std::size_t structures::MpmcQueue<T, Allocator>::claim_enqueue(
+    std::size_t n, std::size_t& pos) {
+    pos = enqueue_pos_.load(std::memory_order_relaxed);
+    for (;;) {
+        // posicao pos + i esta livre quando sua sequencia vale pos + i
+        std::size_t count = 0u;
+        bool stale = false;
+        while (count < n) {
+            std::size_t index = pos + count;
+            std::size_t seq = cells[index & (max_size_ - 1u)]
+                                  .sequence.load(std::memory_order_acquire);
+            if (seq != index) {
+                // seq < index: volta anterior ainda nao consumida (cheia);
+                // seq > index: outro produtor ja passou por aqui
+                stale = static_cast<std::ptrdiff_t>(seq - index) > 0;
+                break;
+            }
+            count++;
+        }
+        if (count == 0u && !stale) {
+            return 0u;
+        }
+        if (count > 0u &&
+            enqueue_pos_.compare_exchange_weak(pos, pos + count,
+                                               std::memory_order_relaxed)) {
+            return count;
+        }
+        if (count == 0u) {
+            pos = enqueue_pos_.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+template<typename T, typename Allocator>
+std::size_t structures::MpmcQueue<T, Allocator>::claim_dequeue(
+    std::size_t n, std::size_t& pos) {
+    pos = dequeue_pos_.load(std::memory_order_relaxed);
+    for (;;) {
+        // posicao pos + i esta ocupada quando sua sequencia vale pos + i + 1
+        std::size_t count = 0u;
+        bool stale = false;
+        while (count < n) {
+            std::size_t index = pos + count;
+            std::size_t seq = cells[index & (max_size_ - 1u)]
+                                  .sequence.load(std::memory_order_acquire);
+            if (seq != index + 1u) {
+                // seq < index + 1: ainda nao produzida (vazia);
+                // seq > index + 1: outro consumidor ja passou por aqui
+                stale = static_cast<std::ptrdiff_t>(seq - (index + 1u)) > 0;
+                break;
+            }
+            count++;
+        }
+        if (count == 0u && !stale) {
+            return 0u;
+        }
+        if (count > 0u &&
+            dequeue_pos_.compare_exchange_weak(pos, pos + count,
+                                               std::memory_order_relaxed)) {
+            return count;
+        }
+        if (count == 0u) {
+            pos = dequeue_pos_.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+template<typename T, typename Allocator>
+bool structures::MpmcQueue<T, Allocator>::try_enqueue(const T& data) {
+    std::size_t pos;
+    if (claim_enqueue(1u, pos) == 0u) {
+        return false;
+    }
+    Cell& cell = cells[pos & (max_size_ - 1u)];
+    cell.data = data;
+    cell.sequence.store(pos + 1u, std::memory_order_release);
+    return true;
+}
+
+template<typename T, typename Allocator>
+bool structures::MpmcQueue<T, Allocator>::try_enqueue(T&& data) {
+    std::size_t pos;
+    if (claim_enqueue(1u, pos) == 0u) {
+        return false;
+    }
+    Cell& cell = cells[pos & (max_size_ - 1u)];
+    cell.data = std::move(data);
+    cell.sequence.store(pos + 1u, std::memory_order_release);
+    return true;
+}
+
+template<typename T, typename Allocator>
+bool structures::MpmcQueue<T, Allocator>::try_dequeue(T& data) {
+    std::size_t pos;
+    if (claim_dequeue(1u, pos) == 0u) {
+        return false;
+    }
+    Cell& cell = cells[pos & (max_size_ - 1u)];
+    data = std::move(cell.data);
+    cell.sequence.store(pos + max_size_, std::memory_order_release);
+    return true;
+}
+
+template<typename T, typename Allocator>
+template<typename InputIt>
+std::size_t structures::MpmcQueue<T, Allocator>::try_enqueue_bulk(
+    InputIt first, std::size_t n) {
+    std::size_t pos;
+    std::size_t count = claim_enqueue(n, pos);
+    for (std::size_t i = 0u; i < count; i++, ++first) {
+        Cell& cell = cells[(pos + i) & (max_size_ - 1u)];
+        cell.data = *first;
+        cell.sequence.store(pos + i + 1u, std::memory_order_release);
+    }
+    return count;
+}
+
+template<typename T, typename Allocator>
+template<typename OutputIt>
+std::size_t structures::MpmcQueue<T, Allocator>::try_dequeue_bulk(
+    OutputIt out, std::size_t max) {
+    std::size_t pos;
+    std::size_t count = claim_dequeue(max, pos);
+    for (std::size_t i = 0u; i < count; i++, ++out) {
+        Cell& cell = cells[(pos + i) & (max_size_ - 1u)];
+        *out = std::move(cell.data);
+        cell.sequence.store(pos + i + max_size_, std::memory_order_release);
+    }
+    return count;
+}
+
+template<typename T, typename Allocator>
+std::size_t structures::MpmcQueue<T, Allocator>::size() const {
+    std::size_t head = dequeue_pos_.load(std::memory_order_acquire);
+    std::size_t tail = enqueue_pos_.load(std::memory_order_acquire);
+    return tail > head ? tail - head : 0u;
+}
+
+template<typename T, typename Allocator>
+std::size_t structures::MpmcQueue<T, Allocator>::max_size() const {
+    return max_size_;
+}
+
+template<typename T, typename Allocator>
+bool structures::MpmcQueue<T, Allocator>::empty() const {
+    return size() == 0u;
+}
+
+#endif
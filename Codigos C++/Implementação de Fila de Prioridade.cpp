@@ -0,0 +1,396 @@
+#ifndef STRUCTURES_PRIORITY_QUEUE_H
+#define STRUCTURES_PRIORITY_QUEUE_H
+
+#include <cstdint>  // std::size_t
+#include <functional>  // std::less
+#include <iterator>  // std::distance
+#include <memory>  // std::allocator, std::allocator_traits
+#include <memory_resource>  // std::pmr::polymorphic_allocator
+#include <stdexcept>  // C++ exceptions
+#include <utility>  // std::move, std::forward
+
+namespace structures {
+
+template<typename T, typename Compare = std::less<T>,
+         typename Allocator = std::allocator<T>>
+//! fila de prioridade em heap 4-ario num vetor contiguo;
+//! o topo e o menor elemento segundo Compare (ex.: prazo mais proximo)
+class PriorityQueue {
+ public:
+    //! identifica um elemento enquanto ele estiver na fila
+    using handle = std::size_t;
+
+    //! construtor padrao
+    explicit PriorityQueue(const Compare& comp = Compare(),
+                           const Allocator& alloc = Allocator());
+    //! construtor a partir de um intervalo, em O(n)
+    template<typename ForwardIt>
+    PriorityQueue(ForwardIt first, ForwardIt last,
+                  const Compare& comp = Compare(),
+                  const Allocator& alloc = Allocator());
+    //! destrutor
+    ~PriorityQueue();
+    PriorityQueue(const PriorityQueue&) = delete;
+    PriorityQueue& operator=(const PriorityQueue&) = delete;
+    //! insere, retorna o handle do elemento
+    handle push(const T& data);
+    //! retira o topo
+    T pop();
+    //! retorna o topo
+    const T& top() const;
+    //! substitui o conteudo pelo intervalo, em O(n);
+    //! o i-esimo elemento recebe o handle i
+    template<typename ForwardIt>
+    void heapify(ForwardIt first, ForwardIt last);
+    //! aproxima o elemento do topo; data nao pode vir depois do atual
+    void decrease_key(handle h, const T& data);
+    //! troca o valor do elemento, em qualquer direcao
+    void update(handle h, const T& data);
+    //! retira o elemento do handle
+    T erase(handle h);
+    //! verifica se o handle ainda esta na fila
+    bool contains(handle h) const;
+    //! valor do elemento do handle
+    const T& at(handle h) const;
+    //! garante capacidade para n elementos
+    void reserve(std::size_t n);
+    //! limpa a fila (invalida todos os handles)
+    void clear();
+    //! tamanho atual
+    std::size_t size() const;
+    //! verifica se vazia
+    bool empty() const;
+
+ private:
+    using Traits = std::allocator_traits<Allocator>;
+    using IndexAllocator =
+        typename Traits::template rebind_alloc<std::size_t>;
+    using IndexTraits = std::allocator_traits<IndexAllocator>;
+
+    static const auto ARITY = 4u;
+    static const auto DEFAULT_SIZE = 16u;
+
+    //! sobe o elemento da posicao i; retorna a posicao final
+    std::size_t sift_up(std::size_t i);
+    //! desce o elemento da posicao i; retorna a posicao final
+    std::size_t sift_down(std::size_t i);
+    //! troca as posicoes i e j (valor e handle)
+    void swap_slots(std::size_t i, std::size_t j);
+    //! posicao do handle, ou excecao se nao estiver na fila
+    std::size_t position(handle h) const;
+    //! realoca os vetores para nova capacidade
+    void grow(std::size_t new_max);
+    //! poe data no fim do heap (ha espaco) e sobe; retorna o handle
+    template<typename U>
+    handle place(U&& data);
+
+    Compare comp_;
+    Allocator alloc_;
+    IndexAllocator index_alloc_;
+    T* contents{nullptr};  // valores em ordem de heap
+    // ids[0, size_) sao os handles do heap; ids[size_, handles_) estao livres
+    std::size_t* ids{nullptr};
+    std::size_t* positions{nullptr};  // positions[h] = indice de h em ids
+    std::size_t size_{0u};
+    std::size_t handles_{0u};
+    std::size_t max_size_{0u};
+};
+
+namespace pmr {
+
+//! PriorityQueue alocando de um std::pmr::memory_resource
+template<typename T, typename Compare = std::less<T>>
+using PriorityQueue = structures::PriorityQueue<
+    T, Compare, std::pmr::polymorphic_allocator<T>>;
+
+}  // namespace pmr
+
+}  // namespace structures
+
+template<typename T, typename Compare, typename Allocator>
+structures::PriorityQueue<T, Compare, Allocator>::PriorityQueue(
+    const Compare& comp, const Allocator& alloc):
+    comp_{comp},
+    alloc_{alloc},
+    index_alloc_{alloc} {
+    grow(DEFAULT_SIZE);
+}
+
+template<typename T, typename Compare, typename Allocator>
+template<typename ForwardIt>
+structures::PriorityQueue<T, Compare, Allocator>::PriorityQueue(
+    ForwardIt first, ForwardIt last, const Compare& comp,
+    const Allocator& alloc):
+    PriorityQueue(comp, alloc) {
+    heapify(first, last);
+}
+
+template<typename T, typename Compare, typename Allocator>
+structures::PriorityQueue<T, Compare, Allocator>::~PriorityQueue() {
+    for (std::size_t i = 0u; i < max_size_; i++) {
+        Traits::destroy(alloc_, contents + i);
+    }
+    Traits::deallocate(alloc_, contents, max_size_);
+    IndexTraits::deallocate(index_alloc_, ids, max_size_);
+    IndexTraits::deallocate(index_alloc_, positions, max_size_);
+}
+
+template<typename T, typename Compare, typename Allocator>
+void structures::PriorityQueue<T, Compare, Allocator>::grow(
+    std::size_t new_max) {
+    // indices primeiro: se falharem, nenhum elemento saiu de contents
+    std::size_t* new_ids = IndexTraits::allocate(index_alloc_, new_max);
+    std::size_t* new_positions = nullptr;
+    T* new_contents = nullptr;
+    std::size_t i = 0u;
+    try {
+        new_positions = IndexTraits::allocate(index_alloc_, new_max);
+        new_contents = Traits::allocate(alloc_, new_max);
+        for (; i < new_max; i++) {
+            Traits::construct(alloc_, new_contents + i);
+        }
+        for (std::size_t j = 0u; j < size_; j++) {
+            new_contents[j] = std::move(contents[j]);
+        }
+    } catch (...) {
+        if (new_contents != nullptr) {
+            while (i > 0u) {
+                Traits::destroy(alloc_, new_contents + --i);
+            }
+            Traits::deallocate(alloc_, new_contents, new_max);
+        }
+        if (new_positions != nullptr) {
+            IndexTraits::deallocate(index_alloc_, new_positions, new_max);
+        }
+        IndexTraits::deallocate(index_alloc_, new_ids, new_max);
+        throw;
+    }
+    for (std::size_t j = 0u; j < handles_; j++) {
+        new_ids[j] = ids[j];
+        new_positions[j] = positions[j];
+    }
+    for (std::size_t j = 0u; j < max_size_; j++) {
+        Traits::destroy(alloc_, contents + j);
+    }
+    if (contents != nullptr) {
+        Traits::deallocate(alloc_, contents, max_size_);
+        IndexTraits::deallocate(index_alloc_, ids, max_size_);
+        IndexTraits::deallocate(index_alloc_, positions, max_size_);
+    }
+    contents = new_contents;
+    ids = new_ids;
+    positions = new_positions;
+    max_size_ = new_max;
+}
+
+template<typename T, typename Compare, typename Allocator>
+void structures::PriorityQueue<T, Compare, Allocator>::swap_slots(
+    std::size_t i, std::size_t j) {
+    std::swap(contents[i], contents[j]);
+    std::swap(ids[i], ids[j]);
+    positions[ids[i]] = i;
+    positions[ids[j]] = j;
+}
+
+template<typename T, typename Compare, typename Allocator>
+std::size_t structures::PriorityQueue<T, Compare, Allocator>::sift_up(
+    std::size_t i) {
+    T data = std::move(contents[i]);
+    std::size_t id = ids[i];
+    while (i > 0u) {
+        std::size_t parent = (i - 1u) / ARITY;
+        if (!comp_(data, contents[parent])) {
+            break;
+        }
+        contents[i] = std::move(contents[parent]);
+        ids[i] = ids[parent];
+        positions[ids[i]] = i;
+        i = parent;
+    }
+    contents[i] = std::move(data);
+    ids[i] = id;
+    positions[id] = i;
+    return i;
+}
+
+template<typename T, typename Compare, typename Allocator>
+std::size_t structures::PriorityQueue<T, Compare, Allocator>::sift_down(
+    std::size_t i) {
+    T data = std::move(contents[i]);
+    std::size_t id = ids[i];
+    for (;;) {
+        std::size_t first = ARITY * i + 1u;
+        if (first >= size_) {
+            break;
+        }
+        // os quatro filhos sao vizinhos no vetor (mesma linha de cache)
+        std::size_t last = first + ARITY < size_ ? first + ARITY : size_;
+        std::size_t best = first;
+        for (std::size_t c = first + 1u; c < last; c++) {
+            if (comp_(contents[c], contents[best])) {
+                best = c;
+            }
+        }
+        if (!comp_(contents[best], data)) {
+            break;
+        }
+        contents[i] = std::move(contents[best]);
+        ids[i] = ids[best];
+        positions[ids[i]] = i;
+        i = best;
+    }
+    contents[i] = std::move(data);
+    ids[i] = id;
+    positions[id] = i;
+    return i;
+}
+
+template<typename T, typename Compare, typename Allocator>
+typename structures::PriorityQueue<T, Compare, Allocator>::handle
+structures::PriorityQueue<T, Compare, Allocator>::push(const T& data) {
+    if (size_ == max_size_) {
+        // data pode ser um elemento desta fila: copia antes de crescer
+        T copy(data);
+        grow(max_size_ * 2u);
+        return place(std::move(copy));
+    }
+    return place(data);
+}
+
+template<typename T, typename Compare, typename Allocator>
+template<typename U>
+typename structures::PriorityQueue<T, Compare, Allocator>::handle
+structures::PriorityQueue<T, Compare, Allocator>::place(U&& data) {
+    if (size_ == handles_) {
+        ids[handles_] = handles_;
+        positions[handles_] = handles_;
+        handles_++;
+    }
+    handle h = ids[size_];
+    contents[size_] = std::forward<U>(data);
+    size_++;
+    sift_up(size_ - 1u);
+    return h;
+}
+
+template<typename T, typename Compare, typename Allocator>
+T structures::PriorityQueue<T, Compare, Allocator>::pop() {
+    if (empty()) {
+        throw std::out_of_range("Fila vazia");
+    }
+    return erase(ids[0]);
+}
+
+template<typename T, typename Compare, typename Allocator>
+const T& structures::PriorityQueue<T, Compare, Allocator>::top() const {
+    if (empty()) {
+        throw std::out_of_range("Fila vazia");
+    }
+    return contents[0];
+}
+
+template<typename T, typename Compare, typename Allocator>
+template<typename ForwardIt>
+void structures::PriorityQueue<T, Compare, Allocator>::heapify(
+    ForwardIt first, ForwardIt last) {
+    std::size_t n = static_cast<std::size_t>(std::distance(first, last));
+    clear();
+    reserve(n);
+    for (std::size_t i = 0u; i < n; i++, ++first) {
+        contents[i] = *first;
+        ids[i] = i;
+        positions[i] = i;
+    }
+    size_ = n;
+    handles_ = n;
+    // desce cada pai, do ultimo ate a raiz: O(n) no total
+    for (std::size_t i = n / ARITY + 1u; i > 0u; i--) {
+        if (i - 1u < n) {
+            sift_down(i - 1u);
+        }
+    }
+}
+
+template<typename T, typename Compare, typename Allocator>
+std::size_t structures::PriorityQueue<T, Compare, Allocator>::position(
+    handle h) const {
+    if (!contains(h)) {
+        throw std::out_of_range("Handle invalido");
+    }
+    return positions[h];
+}
+
+template<typename T, typename Compare, typename Allocator>
+void structures::PriorityQueue<T, Compare, Allocator>::decrease_key(
+    handle h, const T& data) {
+    std::size_t i = position(h);
+    if (comp_(contents[i], data)) {
+        throw std::invalid_argument("Nova chave vem depois da atual");
+    }
+    contents[i] = data;
+    sift_up(i);
+}
+
+template<typename T, typename Compare, typename Allocator>
+void structures::PriorityQueue<T, Compare, Allocator>::update(
+    handle h, const T& data) {
+    std::size_t i = position(h);
+    contents[i] = data;
+    sift_down(sift_up(i));
+}
+
+template<typename T, typename Compare, typename Allocator>
+T structures::PriorityQueue<T, Compare, Allocator>::erase(handle h) {
+    std::size_t i = position(h);
+    std::size_t last = size_ - 1u;
+    // o handle retirado vai para ids[last], que vira a primeira posicao livre
+    swap_slots(i, last);
+    T data = std::move(contents[last]);
+    size_--;
+    if (i < size_) {
+        sift_down(sift_up(i));
+    }
+    return data;
+}
+
+template<typename T, typename Compare, typename Allocator>
+bool structures::PriorityQueue<T, Compare, Allocator>::contains(
+    handle h) const {
+    return h < handles_ && positions[h] < size_;
+}
+
+template<typename T, typename Compare, typename Allocator>
+const T& structures::PriorityQueue<T, Compare, Allocator>::at(
+    handle h) const {
+    return contents[position(h)];
+}
+
+template<typename T, typename Compare, typename Allocator>
+void structures::PriorityQueue<T, Compare, Allocator>::reserve(
+    std::size_t n) {
+    if (n > max_size_) {
+        std::size_t new_max = max_size_;
+        while (new_max < n) {
+            new_max *= 2u;
+        }
+        grow(new_max);
+    }
+}
+
+template<typename T, typename Compare, typename Allocator>
+void structures::PriorityQueue<T, Compare, Allocator>::clear() {
+    size_ = 0u;
+    handles_ = 0u;
+}
+
+template<typename T, typename Compare, typename Allocator>
+std::size_t structures::PriorityQueue<T, Compare, Allocator>::size() const {
+    return size_;
+}
+
+template<typename T, typename Compare, typename Allocator>
+bool structures::PriorityQueue<T, Compare, Allocator>::empty() const {
+    return size_ == 0u;
+}
+
+#endif
@@ -0,0 +1,344 @@
+#ifndef STRUCTURES_SHARED_RING_BUFFER_H
+#define STRUCTURES_SHARED_RING_BUFFER_H
+
+#include <fcntl.h>  // O_CREAT, O_RDWR
+#include <sys/mman.h>  // shm_open, mmap
+#include <sys/stat.h>  // fstat
+#include <unistd.h>  // ftruncate, close
+
+#include <atomic>  // std::atomic
+#include <cerrno>  // errno
+#include <cstdint>  // std::uint32_t, std::uint64_t
+#include <cstring>  // std::memcpy
+#include <new>  // placement new
+#include <stdexcept>  // C++ exceptions
+#include <system_error>  // std::system_error
+#include <type_traits>  // std::is_trivially_copyable
+#include <utility>  // std::swap
+
+namespace structures {
+
+//! anel de bytes em memoria compartilhada (POSIX shm) entre dois processos:
+//! um produtor e um consumidor, registros com prefixo de tamanho.
+//! A regiao so guarda deslocamentos, entao pode ser mapeada em qualquer
+//! endereco; no caminho rapido nao ha chamadas de sistema.
+class SharedRingBuffer {
+ public:
+    //! cria a regiao name com capacidade (arredondada para potencia de 2)
+    static SharedRingBuffer create(const char* name, std::size_t capacity);
+    //! abre uma regiao ja criada por create
+    static SharedRingBuffer open(const char* name);
+    //! remove o nome da regiao (os mapeamentos abertos continuam validos)
+    static void unlink(const char* name);
+
+    SharedRingBuffer(SharedRingBuffer&& other) noexcept;
+    SharedRingBuffer& operator=(SharedRingBuffer&& other) noexcept;
+    SharedRingBuffer(const SharedRingBuffer&) = delete;
+    SharedRingBuffer& operator=(const SharedRingBuffer&) = delete;
+    //! desfaz o mapeamento
+    ~SharedRingBuffer();
+
+    //! produtor: grava um registro de length bytes; false se nao couber agora
+    bool try_write(const void* data, std::size_t length);
+    //! consumidor: le o proximo registro em buffer (ate max bytes);
+    //! false se vazio, excecao se o registro for maior que max
+    bool try_read(void* buffer, std::size_t max, std::size_t& length);
+    //! bytes de dados da regiao
+    std::size_t capacity() const;
+    //! maior registro aceito por try_write
+    std::size_t max_record_size() const;
+    //! verifica se vazio (aproximado se o produtor estiver escrevendo)
+    bool empty() const;
+
+ private:
+    static const std::uint64_t MAGIC = 0x5354525543524e47u;
+    static const std::uint32_t PADDING = 0xffffffffu;
+    static const std::size_t CACHE_LINE = 64u;
+    static const std::size_t ALIGNMENT = 8u;
+
+    static_assert(std::atomic<std::uint64_t>::is_always_lock_free,
+                  "atomicos de 64 bits precisam funcionar entre processos");
+
+    //! cabecalho no inicio da regiao compartilhada
+    struct Header {
+        std::uint64_t magic;
+        std::uint64_t capacity;
+        alignas(CACHE_LINE) std::atomic<std::uint64_t> head;
+        alignas(CACHE_LINE) std::atomic<std::uint64_t> tail;
+    };
+
+    static const std::size_t DATA_OFFSET =
+        (sizeof(Header) + CACHE_LINE - 1u) / CACHE_LINE * CACHE_LINE;
+
+    SharedRingBuffer(int fd, void* region, std::size_t length);
+    //! mapeia fd inteiro, lancando std::system_error em caso de falha
+    static void* map(int fd, std::size_t length);
+    //! tamanho ocupado por um registro de length bytes (prefixo + alinhamento)
+    static std::uint64_t record_size(std::size_t length);
+
+    Header* header() const;
+    unsigned char* data() const;
+
+    int fd_{-1};
+    void* region_{nullptr};
+    std::size_t length_{0u};
+    std::uint64_t head_cache_{0u};  // produtor: ultima copia vista de head
+    std::uint64_t tail_cache_{0u};  // consumidor: ultima copia vista de tail
+};
+
+//! fila de registros de tamanho fixo sobre SharedRingBuffer
+template<typename T>
+class SharedQueue {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "so tipos copiaveis por bytes podem ir para outro processo");
+
+ public:
+    //! cria a regiao name com espaco para pelo menos max registros
+    //! (um registro extra cobre o trecho pulado na volta do anel)
+    static SharedQueue create(const char* name, std::size_t max) {
+        return SharedQueue(
+            SharedRingBuffer::create(name, (max + 1u) * RECORD));
+    }
+
+    //! abre uma regiao ja criada por create
+    static SharedQueue open(const char* name) {
+        return SharedQueue(SharedRingBuffer::open(name));
+    }
+
+    //! produtor: enfileira; false se cheia
+    bool try_enqueue(const T& data) {
+        return ring_.try_write(&data, sizeof(T));
+    }
+
+    //! consumidor: desenfileira em data; false se vazia
+    bool try_dequeue(T& data) {
+        std::size_t length;
+        return ring_.try_read(&data, sizeof(T), length);
+    }
+
+    //! verifica se vazia
+    bool empty() const {
+        return ring_.empty();
+    }
+
+ private:
+    static const std::size_t RECORD =
+        (sizeof(std::uint32_t) + sizeof(T) + 7u) / 8u * 8u;
+
+    explicit SharedQueue(SharedRingBuffer&& ring):
+        ring_{std::move(ring)}
+    {}
+
+    SharedRingBuffer ring_;
+};
+
+}  // namespace structures
+
+inline structures::SharedRingBuffer structures::SharedRingBuffer::create(
+    const char* name, std::size_t capacity) {
+    std::size_t size = CACHE_LINE;
+    while (size < capacity) {
+        size <<= 1;
+    }
+    int fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0) {
+        throw std::system_error(errno, std::generic_category(), "shm_open");
+    }
+    std::size_t length = DATA_OFFSET + size;
+    if (ftruncate(fd, static_cast<off_t>(length)) != 0) {
+        int error = errno;
+        ::close(fd);
+        shm_unlink(name);
+        throw std::system_error(error, std::generic_category(), "ftruncate");
+    }
+    void* region;
+    try {
+        region = map(fd, length);
+    } catch (...) {
+        ::close(fd);
+        shm_unlink(name);
+        throw;
+    }
+    Header* h = new (region) Header;
+    h->capacity = size;
+    h->head.store(0u, std::memory_order_relaxed);
+    h->tail.store(0u, std::memory_order_relaxed);
+    // magic por ultimo: open so aceita a regiao depois de inicializada
+    std::atomic_thread_fence(std::memory_order_release);
+    h->magic = MAGIC;
+    return SharedRingBuffer(fd, region, length);
+}
+
+inline structures::SharedRingBuffer structures::SharedRingBuffer::open(
+    const char* name) {
+    int fd = shm_open(name, O_RDWR, 0600);
+    if (fd < 0) {
+        throw std::system_error(errno, std::generic_category(), "shm_open");
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        int error = errno;
+        ::close(fd);
+        throw std::system_error(error, std::generic_category(), "fstat");
+    }
+    std::size_t length = static_cast<std::size_t>(info.st_size);
+    if (length <= DATA_OFFSET) {
+        ::close(fd);
+        throw std::runtime_error("Regiao compartilhada invalida");
+    }
+    void* region;
+    try {
+        region = map(fd, length);
+    } catch (...) {
+        ::close(fd);
+        throw;
+    }
+    SharedRingBuffer ring(fd, region, length);
+    const Header* h = ring.header();
+    if (h->magic != MAGIC || h->capacity != length - DATA_OFFSET) {
+        throw std::runtime_error("Regiao compartilhada invalida");
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    ring.head_cache_ = h->head.load(std::memory_order_acquire);
+    ring.tail_cache_ = h->tail.load(std::memory_order_acquire);
+    return ring;
+}
+
+inline void structures::SharedRingBuffer::unlink(const char* name) {
+    if (shm_unlink(name) != 0) {
+        throw std::system_error(errno, std::generic_category(), "shm_unlink");
+    }
+}
+
+inline structures::SharedRingBuffer::SharedRingBuffer(int fd, void* region,
+                                                      std::size_t length):
+    fd_{fd},
+    region_{region},
+    length_{length}
+{}
+
+inline structures::SharedRingBuffer::SharedRingBuffer(
+    SharedRingBuffer&& other) noexcept {
+    *this = std::move(other);
+}
+
+inline structures::SharedRingBuffer&
+structures::SharedRingBuffer::operator=(SharedRingBuffer&& other) noexcept {
+    std::swap(fd_, other.fd_);
+    std::swap(region_, other.region_);
+    std::swap(length_, other.length_);
+    std::swap(head_cache_, other.head_cache_);
+    std::swap(tail_cache_, other.tail_cache_);
+    return *this;
+}
+
+inline structures::SharedRingBuffer::~SharedRingBuffer() {
+    if (region_ != nullptr) {
+        munmap(region_, length_);
+    }
+    if (fd_ >= 0) {
+        ::close(fd_);
+    }
+}
+
+inline void* structures::SharedRingBuffer::map(int fd, std::size_t length) {
+    void* region = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED,
+                        fd, 0);
+    if (region == MAP_FAILED) {
+        throw std::system_error(errno, std::generic_category(), "mmap");
+    }
+    return region;
+}
+
+inline std::uint64_t structures::SharedRingBuffer::record_size(
+    std::size_t length) {
+    return (sizeof(std::uint32_t) + length + ALIGNMENT - 1u) / ALIGNMENT *
+           ALIGNMENT;
+}
+
+inline structures::SharedRingBuffer::Header*
+structures::SharedRingBuffer::header() const {
+    return static_cast<Header*>(region_);
+}
+
+inline unsigned char* structures::SharedRingBuffer::data() const {
+    return static_cast<unsigned char*>(region_) + DATA_OFFSET;
+}
+
+inline bool structures::SharedRingBuffer::try_write(const void* data_,
+                                                    std::size_t length) {
+    if (length > max_record_size()) {
+        throw std::length_error("Registro maior que o anel");
+    }
+    Header* h = header();
+    const std::uint64_t capacity = h->capacity;
+    std::uint64_t tail = h->tail.load(std::memory_order_relaxed);
+    std::uint64_t pos = tail & (capacity - 1u);
+    std::uint64_t size = record_size(length);
+    // registro nao se divide: se nao cabe ate o fim, pula para o inicio
+    std::uint64_t skip = capacity - pos < size ? capacity - pos : 0u;
+    if (tail + skip + size - head_cache_ > capacity) {
+        head_cache_ = h->head.load(std::memory_order_acquire);
+        if (tail + skip + size - head_cache_ > capacity) {
+            return false;
+        }
+    }
+    if (skip > 0u) {
+        std::memcpy(data() + pos, &PADDING, sizeof(PADDING));
+        tail += skip;
+        pos = 0u;
+    }
+    std::uint32_t prefix = static_cast<std::uint32_t>(length);
+    std::memcpy(data() + pos, &prefix, sizeof(prefix));
+    std::memcpy(data() + pos + sizeof(prefix), data_, length);
+    h->tail.store(tail + size, std::memory_order_release);
+    return true;
+}
+
+inline bool structures::SharedRingBuffer::try_read(void* buffer,
+                                                   std::size_t max,
+                                                   std::size_t& length) {
+    Header* h = header();
+    const std::uint64_t capacity = h->capacity;
+    std::uint64_t head = h->head.load(std::memory_order_relaxed);
+    for (;;) {
+        if (head == tail_cache_) {
+            tail_cache_ = h->tail.load(std::memory_order_acquire);
+            if (head == tail_cache_) {
+                return false;
+            }
+        }
+        std::uint64_t pos = head & (capacity - 1u);
+        std::uint32_t prefix;
+        std::memcpy(&prefix, data() + pos, sizeof(prefix));
+        if (prefix != PADDING) {
+            if (prefix > max) {
+                throw std::length_error("Buffer menor que o registro");
+            }
+            std::memcpy(buffer, data() + pos + sizeof(prefix), prefix);
+            length = prefix;
+            h->head.store(head + record_size(prefix),
+                          std::memory_order_release);
+            return true;
+        }
+        head += capacity - pos;
+        h->head.store(head, std::memory_order_release);
+    }
+}
+
+inline std::size_t structures::SharedRingBuffer::capacity() const {
+    return static_cast<std::size_t>(header()->capacity);
+}
+
+inline std::size_t structures::SharedRingBuffer::max_record_size() const {
+    // metade do anel: sempre cabe, mesmo precisando pular ate o inicio
+    return capacity() / 2u - sizeof(std::uint32_t);
+}
+
+inline bool structures::SharedRingBuffer::empty() const {
+    const Header* h = header();
+    return h->head.load(std::memory_order_acquire) ==
+           h->tail.load(std::memory_order_acquire);
+}
+
+#endif
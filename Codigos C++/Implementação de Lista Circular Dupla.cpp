@@ -1,13 +1,19 @@
 // Copyright [2023] <Claudio Gerolimetto>
 
 #include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <utility>
+
+#include "slab_allocator.h"
 
 namespace structures {
 
-template<typename T>
+template<typename T, typename Allocator = SlabAllocator<T>>
 class DoublyCircularList {
  public:
     DoublyCircularList();
+    explicit DoublyCircularList(const Allocator& alloc);
     ~DoublyCircularList();
     void clear();
 
@@ -21,6 +27,11 @@ class DoublyCircularList {
     T pop_front();
     void remove(const T& data);
 
+    //! gira o anel: o elemento de indice k vira o primeiro (k = 1 passa a
+    //! vez para o proximo). So move head e tail, sem alocar; anda o menor
+    //! caminho, entao rotate(size() - 1) volta um passo
+    void rotate(std::size_t k = 1u);
+
     bool empty() const;
     bool contains(const T& data) const;
 
@@ -30,6 +41,8 @@ class DoublyCircularList {
     std::size_t find(const T& data) const;
     std::size_t size() const;
 
+    Allocator get_allocator() const;
+
  private:
     class Node {
      public:
@@ -86,45 +99,133 @@ class DoublyCircularList {
         Node* next_{nullptr};
     };
 
-    Node* node_at(std::size_t index) {
+    using NodeAllocator =
+        typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+    using NodeTraits = std::allocator_traits<NodeAllocator>;
+
+    template<typename... Args>
+    Node* allocate_node(Args&&... args) {
+        Node* node = NodeTraits::allocate(alloc_, 1);
+        try {
+            NodeTraits::construct(alloc_, node, std::forward<Args>(args)...);
+        } catch (...) {
+            NodeTraits::deallocate(alloc_, node, 1);
+            throw;
+        }
+        return node;
+    }
+
+    void deallocate_node(Node* node) {
+        NodeTraits::destroy(alloc_, node);
+        NodeTraits::deallocate(alloc_, node, 1);
+    }
+
+    //! nodo na posicao index, andando a partir do mais perto entre
+    //! head, tail e o ultimo nodo acessado (finger); so le o finger, entao
+    //! leituras const concorrentes continuam seguras
+    Node* locate(std::size_t index) const {
         Node* it = head;
-        for (std::size_t i = 0; i < index; ++i) {
+        std::size_t from = 0;
+        std::size_t distance = index;
+        if (size_ - 1 - index < distance) {
+            it = tail;
+            from = size_ - 1;
+            distance = size_ - 1 - index;
+        }
+        if (finger_ != nullptr) {
+            std::size_t gap = finger_index_ > index ? finger_index_ - index
+                                                    : index - finger_index_;
+            if (gap < distance) {
+                it = finger_;
+                from = finger_index_;
+            }
+        }
+        for (; from < index; ++from) {
             it = it->next();
         }
+        for (; from > index; --from) {
+            it = it->prev();
+        }
         return it;
     }
 
+    //! locate que tambem move o finger para o nodo achado
+    Node* node_at(std::size_t index) {
+        Node* it = locate(index);
+        finger_ = it;
+        finger_index_ = index;
+        return it;
+    }
+
+    //! corrige o finger depois de inserir na posicao index
+    void finger_inserted(std::size_t index) {
+        if (finger_ != nullptr && finger_index_ >= index) {
+            finger_index_++;
+        }
+    }
+
+    //! corrige o finger depois de retirar a posicao index
+    void finger_erased(std::size_t index) {
+        if (finger_ != nullptr) {
+            if (finger_index_ == index) {
+                finger_ = nullptr;
+            } else if (finger_index_ > index) {
+                finger_index_--;
+            }
+        }
+    }
+
+    NodeAllocator alloc_{};
     Node* head{nullptr};
     Node* tail{nullptr};
     std::size_t size_{0u};
+    Node* finger_{nullptr};  // cache do ultimo node_at
+    std::size_t finger_index_{0u};
 };
 
-}  // namespace structures
+namespace pmr {
 
 template<typename T>
-structures::DoublyCircularList<T>::DoublyCircularList() {}
+using DoublyCircularList =
+    structures::DoublyCircularList<T, std::pmr::polymorphic_allocator<T>>;
 
-template<typename T>
-structures::DoublyCircularList<T>::~DoublyCircularList() {
+}  // namespace pmr
+
+}  // namespace structures
+
+template<typename T, typename Allocator>
+structures::DoublyCircularList<T, Allocator>::DoublyCircularList() {}
+
+template<typename T, typename Allocator>
+structures::DoublyCircularList<T, Allocator>::
+DoublyCircularList(const Allocator& alloc):
+    alloc_{alloc}
+{}
+
+template<typename T, typename Allocator>
+structures::DoublyCircularList<T, Allocator>::~DoublyCircularList() {
     clear();
 }
 
-template<typename T>
-void structures::DoublyCircularList<T>::clear() {
+template<typename T, typename Allocator>
+void structures::DoublyCircularList<T, Allocator>::clear() {
+    DeallocationBatch<NodeAllocator> batch(alloc_);
     Node* last = head;
     for (std::size_t i = 0; i < size_; i++) {
         Node* next = last->next();
-        delete last;
+        NodeTraits::destroy(alloc_, last);
+        batch.add(last);
         last = next;
     }
     head = nullptr;
     tail = nullptr;
     size_ = 0;
+    finger_ = nullptr;
 }
 
-template<typename T>
-void structures::DoublyCircularList<T>::push_back(const T& data) {
-    Node* new_node = new Node(data);
+template<typename T, typename Allocator>
+void structures::DoublyCircularList<T, Allocator>::push_back(const T& data) {
+    Node* new_node = allocate_node(data);
     if (size_ == 0) {
         head = new_node;
     } else {
@@ -137,9 +238,9 @@ void structures::DoublyCircularList<T>::push_back(const T& data) {
     size_++;
 }
 
-template<typename T>
-void structures::DoublyCircularList<T>::push_front(const T& data) {
-    Node* new_node = new Node(data, head);
+template<typename T, typename Allocator>
+void structures::DoublyCircularList<T, Allocator>::push_front(const T& data) {
+    Node* new_node = allocate_node(data, head);
     if (empty()) {
         head = new_node;
         tail = new_node;
@@ -152,10 +253,11 @@ void structures::DoublyCircularList<T>::push_front(const T& data) {
         head->prev(tail);
     }
     size_++;
+    finger_inserted(0);
 }
 
-template<typename T>
-void structures::DoublyCircularList<T>::
+template<typename T, typename Allocator>
+void structures::DoublyCircularList<T, Allocator>::
 insert(const T& data, std::size_t index) {
     if (index < 0 || index > size_) {
         throw std::out_of_range("invalid index");
@@ -165,15 +267,17 @@ insert(const T& data, std::size_t index) {
         push_back(data);
     } else {
         Node* current = node_at(index);
-        Node* new_node = new Node(data, current->prev(), current);
+        Node* new_node = allocate_node(data, current->prev(), current);
         current->prev()->next(new_node);
         current->prev(new_node);
         size_++;
+        finger_inserted(index);
     }
 }
 
-template<typename T>
-void structures::DoublyCircularList<T>::insert_sorted(const T& data) {
+template<typename T, typename Allocator>
+void structures::DoublyCircularList<T, Allocator>::
+insert_sorted(const T& data) {
     Node* current = head;
 
     for (std::size_t i = 0; i < size_; i++) {
@@ -186,8 +290,8 @@ void structures::DoublyCircularList<T>::insert_sorted(const T& data) {
     push_back(data);
 }
 
-template<typename T>
-T structures::DoublyCircularList<T>::pop(std::size_t index) {
+template<typename T, typename Allocator>
+T structures::DoublyCircularList<T, Allocator>::pop(std::size_t index) {
     if (size_ == 0) {
         throw std::out_of_range("the list is empty");
     }
@@ -207,13 +311,14 @@ T structures::DoublyCircularList<T>::pop(std::size_t index) {
     previous->next(following);
 
     T data = popped->data();
-    delete popped;
+    deallocate_node(popped);
     size_--;
+    finger_erased(index);
     return data;
 }
 
-template<typename T>
-T structures::DoublyCircularList<T>::pop_back() {
+template<typename T, typename Allocator>
+T structures::DoublyCircularList<T, Allocator>::pop_back() {
     if (empty()) {
         throw std::out_of_range("List is empty");
     }
@@ -230,13 +335,14 @@ T structures::DoublyCircularList<T>::pop_back() {
         head->prev(tail);
     }
 
-    delete popped;
+    deallocate_node(popped);
     size_--;
+    finger_erased(size_);
     return data;
 }
 
-template<typename T>
-T structures::DoublyCircularList<T>::pop_front() {
+template<typename T, typename Allocator>
+T structures::DoublyCircularList<T, Allocator>::pop_front() {
     if (empty()) {
         throw std::out_of_range("List is empty");
     }
@@ -253,44 +359,72 @@ T structures::DoublyCircularList<T>::pop_front() {
         head->prev(tail);
     }
 
-    delete popped;
+    deallocate_node(popped);
     size_--;
+    finger_erased(0);
     return data;
 }
 
-template<typename T>
-void structures::DoublyCircularList<T>::remove(const T& data) {
+template<typename T, typename Allocator>
+void structures::DoublyCircularList<T, Allocator>::remove(const T& data) {
     pop(find(data));
 }
 
-template<typename T>
-bool structures::DoublyCircularList<T>::empty() const {
+template<typename T, typename Allocator>
+void structures::DoublyCircularList<T, Allocator>::rotate(std::size_t k) {
+    if (size_ == 0) {
+        return;
+    }
+    k %= size_;
+    if (k == 0) {
+        return;
+    }
+    if (k <= size_ - k) {
+        for (std::size_t i = 0; i < k; i++) {
+            head = head->next();
+        }
+    } else {
+        for (std::size_t i = k; i < size_; i++) {
+            head = head->prev();
+        }
+    }
+    tail = head->prev();
+    if (finger_ != nullptr) {
+        finger_index_ = (finger_index_ + size_ - k) % size_;
+    }
+}
+
+template<typename T, typename Allocator>
+bool structures::DoublyCircularList<T, Allocator>::empty() const {
     return size_ == 0;
 }
 
-template<typename T>
-bool structures::DoublyCircularList<T>::contains(const T& data) const {
+template<typename T, typename Allocator>
+bool structures::DoublyCircularList<T, Allocator>::
+contains(const T& data) const {
     return find(data) != size_;
 }
 
-template<typename T>
-T& structures::DoublyCircularList<T>::at(std::size_t index) {
+template<typename T, typename Allocator>
+T& structures::DoublyCircularList<T, Allocator>::at(std::size_t index) {
     if (index < 0 || index >= size_) {
         throw std::out_of_range("invalid index");
     }
     return node_at(index)->data();
 }
 
-template<typename T>
-const T& structures::DoublyCircularList<T>::at(std::size_t index) const {
+template<typename T, typename Allocator>
+const T& structures::DoublyCircularList<T, Allocator>::
+at(std::size_t index) const {
     if (index < 0 || index >= size_) {
         throw std::out_of_range("invalid index");
     }
-    return node_at(index)->data();
+    return locate(index)->data();
 }
 
-template<typename T>
-std::size_t structures::DoublyCircularList<T>::find(const T& data) const {
+template<typename T, typename Allocator>
+std::size_t structures::DoublyCircularList<T, Allocator>::
+find(const T& data) const {
     Node* current = head;
     for (std::size_t i = 0; i < size_; i++) {
         if (data == current->data()) {
@@ -301,7 +435,12 @@ std::size_t structures::DoublyCircularList<T>::find(const T& data) const {
     return size_;
 }
 
-template<typename T>
-std::size_t structures::DoublyCircularList<T>::size() const {
+template<typename T, typename Allocator>
+std::size_t structures::DoublyCircularList<T, Allocator>::size() const {
     return size_;
 }
+
+template<typename T, typename Allocator>
+Allocator structures::DoublyCircularList<T, Allocator>::get_allocator() const {
+    return Allocator(alloc_);
+}
@@ -0,0 +1,638 @@
+#ifndef STRUCTURES_INDEX_LINKED_LIST_H
+#define STRUCTURES_INDEX_LINKED_LIST_H
+
+#include <cstdint>  // std::size_t, std::uint32_t
+#include <functional>  // std::less
+#include <memory>  // std::allocator, std::allocator_traits
+#include <memory_resource>  // std::pmr::polymorphic_allocator
+#include <stdexcept>  // C++ exceptions
+#include <utility>  // std::move, std::move_if_noexcept
+
+namespace structures {
+
+template<typename T, typename Allocator = std::allocator<T>>
+//! lista duplamente encadeada com a interface da DoublyLinkedList, mas
+//! guardada em tres vetores paralelos (dados, next, prev) ligados por
+//! indices de 32 bits; posicoes livres formam uma lista por next.
+//! Custo por elemento: sizeof(T) + 8 bytes, sem cabecalho de malloc
+class IndexLinkedList {
+ public:
+    IndexLinkedList();
+    explicit IndexLinkedList(const Allocator& alloc);
+    ~IndexLinkedList();
+    IndexLinkedList(const IndexLinkedList&) = delete;
+    IndexLinkedList& operator=(const IndexLinkedList&) = delete;
+    void clear();
+
+    void push_back(const T& data);
+    void push_front(const T& data);
+    void insert(const T& data, std::size_t index);
+    void insert_sorted(const T& data);
+
+    T pop(std::size_t index);
+    T pop_back();
+    T pop_front();
+    void remove(const T& data);
+
+    //! merge sort estavel religando os indices (sem mover dados)
+    template<typename Compare = std::less<T>>
+    void sort(Compare comp = Compare());
+    //! intercala other (ordenada) nesta lista (ordenada) em O(n + m)
+    template<typename Compare = std::less<T>>
+    void merge(IndexLinkedList& other, Compare comp = Compare());
+
+    //! reescreve os vetores na ordem da lista: percursos viram varreduras
+    //! sequenciais; cursores ficam invalidos
+    void compact();
+    //! reserva espaco para capacity elementos
+    void reserve(std::size_t capacity);
+
+    bool empty() const;
+    bool contains(const T& data) const;
+
+    T& at(std::size_t index);
+    const T& at(std::size_t index) const;
+
+    std::size_t find(const T& data) const;
+    std::size_t size() const;
+    std::size_t capacity() const;
+
+    Allocator get_allocator() const;
+
+    class Cursor;
+    //! cursor na posicao index (index == size(): depois do ultimo)
+    Cursor cursor(std::size_t index = 0u);
+
+ private:
+    static const std::uint32_t NIL = UINT32_MAX;
+
+    using Traits = std::allocator_traits<Allocator>;
+    using LinkAllocator =
+        typename Traits::template rebind_alloc<std::uint32_t>;
+    using LinkTraits = std::allocator_traits<LinkAllocator>;
+
+    //! posicao livre com data construido (cresce se preciso)
+    std::uint32_t acquire(const T& data);
+    //! destroi o dado e devolve a posicao a lista livre
+    void release(std::uint32_t id);
+    //! liga id antes de position (NIL: no fim)
+    void link_before(std::uint32_t id, std::uint32_t position);
+    //! desliga id da lista, sem liberar
+    void unlink(std::uint32_t id);
+    //! posicao do elemento de indice index, andando da ponta mais perto
+    std::uint32_t node_at(std::size_t index) const;
+    //! troca os vetores por outros com capacity posicoes; em ordem, os
+    //! elementos vao para 0..size-1 na ordem da lista
+    void reallocate(std::size_t capacity, bool in_order);
+    //! intercala dois trechos ligados por next; no empate vem o de a
+    template<typename Compare>
+    std::uint32_t merge_runs(std::uint32_t a, std::uint32_t b,
+                             Compare& comp);
+    //! refaz prev e tail a partir de head depois de religar por next
+    void relink();
+
+    Allocator alloc_{};
+    T* data_{nullptr};
+    std::uint32_t* next_{nullptr};
+    std::uint32_t* prev_{nullptr};
+    std::size_t capacity_{0u};
+    std::uint32_t head{NIL};
+    std::uint32_t tail{NIL};
+    std::uint32_t free_{NIL};
+    std::size_t size_{0u};
+
+ public:
+    //! posicao estavel na lista: editar em volta do cursor e O(1);
+    //! invalido se o elemento sair por outro caminho ou apos compact
+    class Cursor {
+     public:
+        //! dado na posicao atual
+        T& data();
+        //! true se esta depois do ultimo elemento
+        bool end() const;
+        //! vai para o proximo (do ultimo vai para end)
+        void advance();
+        //! volta para o anterior (de end volta para o ultimo)
+        void retreat();
+        //! insere antes da posicao atual (em end, insere no fim)
+        void insert_before(const T& data);
+        //! insere depois da posicao atual
+        void insert_after(const T& data);
+        //! retira o elemento atual; o cursor passa para o seguinte
+        T erase();
+
+     private:
+        friend class IndexLinkedList;
+
+        Cursor(IndexLinkedList* list, std::uint32_t id):
+            list_{list},
+            id_{id}
+        {}
+
+        IndexLinkedList* list_;
+        std::uint32_t id_;  // NIL = end
+    };
+};
+
+namespace pmr {
+
+template<typename T>
+using IndexLinkedList =
+    structures::IndexLinkedList<T, std::pmr::polymorphic_allocator<T>>;
+
+}  // namespace pmr
+
+}  // namespace structures
+
+template<typename T, typename Allocator>
+structures::IndexLinkedList<T, Allocator>::IndexLinkedList() {}
+
+template<typename T, typename Allocator>
+structures::IndexLinkedList<T, Allocator>::
+IndexLinkedList(const Allocator& alloc):
+    alloc_{alloc}
+{}
+
+template<typename T, typename Allocator>
+structures::IndexLinkedList<T, Allocator>::~IndexLinkedList() {
+    clear();
+    if (capacity_ > 0u) {
+        LinkAllocator links(alloc_);
+        LinkTraits::deallocate(links, prev_, capacity_);
+        LinkTraits::deallocate(links, next_, capacity_);
+        Traits::deallocate(alloc_, data_, capacity_);
+    }
+}
+
+template<typename T, typename Allocator>
+void structures::IndexLinkedList<T, Allocator>::clear() {
+    for (std::uint32_t it = head; it != NIL; it = next_[it]) {
+        Traits::destroy(alloc_, data_ + it);
+    }
+    // mantem a memoria: todas as posicoes voltam para a lista livre
+    for (std::size_t i = 0u; i < capacity_; i++) {
+        next_[i] = i + 1u < capacity_ ? static_cast<std::uint32_t>(i + 1u)
+                                      : NIL;
+    }
+    free_ = capacity_ > 0u ? 0u : NIL;
+    head = NIL;
+    tail = NIL;
+    size_ = 0u;
+}
+
+template<typename T, typename Allocator>
+void structures::IndexLinkedList<T, Allocator>::reallocate(
+    std::size_t capacity, bool in_order) {
+    LinkAllocator links(alloc_);
+    T* data = Traits::allocate(alloc_, capacity);
+    std::uint32_t* next = nullptr;
+    std::uint32_t* prev = nullptr;
+    std::size_t moved = 0u;
+    try {
+        next = LinkTraits::allocate(links, capacity);
+        prev = LinkTraits::allocate(links, capacity);
+        for (std::uint32_t it = head; it != NIL; it = next_[it]) {
+            std::size_t to = in_order ? moved : it;
+            Traits::construct(alloc_, data + to,
+                              std::move_if_noexcept(data_[it]));
+            moved++;
+        }
+    } catch (...) {
+        std::size_t undone = 0u;
+        for (std::uint32_t it = head; undone < moved; it = next_[it]) {
+            Traits::destroy(alloc_, data + (in_order ? undone : it));
+            undone++;
+        }
+        if (prev != nullptr) {
+            LinkTraits::deallocate(links, prev, capacity);
+        }
+        if (next != nullptr) {
+            LinkTraits::deallocate(links, next, capacity);
+        }
+        Traits::deallocate(alloc_, data, capacity);
+        throw;
+    }
+    for (std::uint32_t it = head; it != NIL; it = next_[it]) {
+        Traits::destroy(alloc_, data_ + it);
+    }
+    std::size_t first_free;
+    if (in_order) {
+        for (std::size_t i = 0u; i < size_; i++) {
+            next[i] = i + 1u < size_ ? static_cast<std::uint32_t>(i + 1u)
+                                     : NIL;
+            prev[i] = i > 0u ? static_cast<std::uint32_t>(i - 1u) : NIL;
+        }
+        head = size_ > 0u ? 0u : NIL;
+        tail = size_ > 0u ? static_cast<std::uint32_t>(size_ - 1u) : NIL;
+        free_ = NIL;
+        first_free = size_;
+    } else {
+        for (std::size_t i = 0u; i < capacity_; i++) {
+            next[i] = next_[i];
+            prev[i] = prev_[i];
+        }
+        first_free = capacity_;
+    }
+    // posicoes novas entram na frente da lista livre, em ordem crescente
+    for (std::size_t i = capacity; i-- > first_free;) {
+        next[i] = free_;
+        free_ = static_cast<std::uint32_t>(i);
+    }
+    if (capacity_ > 0u) {
+        LinkTraits::deallocate(links, prev_, capacity_);
+        LinkTraits::deallocate(links, next_, capacity_);
+        Traits::deallocate(alloc_, data_, capacity_);
+    }
+    capacity_ = capacity;
+    data_ = data;
+    next_ = next;
+    prev_ = prev;
+}
+
+template<typename T, typename Allocator>
+std::uint32_t structures::IndexLinkedList<T, Allocator>::acquire(
+    const T& data) {
+    if (free_ == NIL) {
+        if (capacity_ == NIL) {
+            throw std::out_of_range("the list is full");
+        }
+        // data pode ser um elemento da propria lista: copia antes de crescer
+        T copy(data);
+        std::size_t capacity = capacity_ < 8u ? 8u : capacity_ * 2u;
+        reallocate(capacity < NIL ? capacity : NIL, false);
+        std::uint32_t id = free_;
+        Traits::construct(alloc_, data_ + id, std::move(copy));
+        free_ = next_[id];
+        return id;
+    }
+    std::uint32_t id = free_;
+    Traits::construct(alloc_, data_ + id, data);
+    free_ = next_[id];
+    return id;
+}
+
+template<typename T, typename Allocator>
+void structures::IndexLinkedList<T, Allocator>::release(std::uint32_t id) {
+    Traits::destroy(alloc_, data_ + id);
+    next_[id] = free_;
+    free_ = id;
+}
+
+template<typename T, typename Allocator>
+void structures::IndexLinkedList<T, Allocator>::link_before(
+    std::uint32_t id, std::uint32_t position) {
+    std::uint32_t previous = position == NIL ? tail : prev_[position];
+    prev_[id] = previous;
+    next_[id] = position;
+    if (previous == NIL) {
+        head = id;
+    } else {
+        next_[previous] = id;
+    }
+    if (position == NIL) {
+        tail = id;
+    } else {
+        prev_[position] = id;
+    }
+    size_++;
+}
+
+template<typename T, typename Allocator>
+void structures::IndexLinkedList<T, Allocator>::unlink(std::uint32_t id) {
+    if (prev_[id] == NIL) {
+        head = next_[id];
+    } else {
+        next_[prev_[id]] = next_[id];
+    }
+    if (next_[id] == NIL) {
+        tail = prev_[id];
+    } else {
+        prev_[next_[id]] = prev_[id];
+    }
+    size_--;
+}
+
+template<typename T, typename Allocator>
+std::uint32_t structures::IndexLinkedList<T, Allocator>::node_at(
+    std::size_t index) const {
+    std::uint32_t it;
+    if (index < size_ - index) {
+        it = head;
+        for (std::size_t i = 0u; i < index; i++) {
+            it = next_[it];
+        }
+    } else {
+        it = tail;
+        for (std::size_t i = size_ - 1u; i > index; i--) {
+            it = prev_[it];
+        }
+    }
+    return it;
+}
+
+template<typename T, typename Allocator>
+void structures::IndexLinkedList<T, Allocator>::push_back(const T& data) {
+    link_before(acquire(data), NIL);
+}
+
+template<typename T, typename Allocator>
+void structures::IndexLinkedList<T, Allocator>::push_front(const T& data) {
+    link_before(acquire(data), head);
+}
+
+template<typename T, typename Allocator>
+void structures::IndexLinkedList<T, Allocator>::insert(const T& data,
+                                                       std::size_t index) {
+    if (index > size_) {
+        throw std::out_of_range("invalid index");
+    }
+    // acquire antes de node_at: crescer nao muda os indices
+    std::uint32_t id = acquire(data);
+    link_before(id, index == size_ ? NIL : node_at(index));
+}
+
+template<typename T, typename Allocator>
+void structures::IndexLinkedList<T, Allocator>::insert_sorted(const T& data) {
+    // compara com a copia: acquire pode ter realocado o que data referia
+    std::uint32_t id = acquire(data);
+    std::uint32_t it = head;
+    while (it != NIL && !(data_[id] <= data_[it])) {
+        it = next_[it];
+    }
+    link_before(id, it);
+}
+
+template<typename T, typename Allocator>
+T structures::IndexLinkedList<T, Allocator>::pop(std::size_t index) {
+    if (size_ == 0u) {
+        throw std::out_of_range("the list is empty");
+    }
+    if (index >= size_) {
+        throw std::out_of_range("invalid index");
+    }
+    std::uint32_t id = node_at(index);
+    unlink(id);
+    T data = std::move(data_[id]);
+    release(id);
+    return data;
+}
+
+template<typename T, typename Allocator>
+T structures::IndexLinkedList<T, Allocator>::pop_back() {
+    if (size_ == 0u) {
+        throw std::out_of_range("the list is empty");
+    }
+    return pop(size_ - 1u);
+}
+
+template<typename T, typename Allocator>
+T structures::IndexLinkedList<T, Allocator>::pop_front() {
+    if (size_ == 0u) {
+        throw std::out_of_range("the list is empty");
+    }
+    return pop(0u);
+}
+
+template<typename T, typename Allocator>
+void structures::IndexLinkedList<T, Allocator>::remove(const T& data) {
+    pop(find(data));
+}
+
+template<typename T, typename Allocator>
+template<typename Compare>
+std::uint32_t structures::IndexLinkedList<T, Allocator>::merge_runs(
+    std::uint32_t a, std::uint32_t b, Compare& comp) {
+    std::uint32_t first = NIL;
+    std::uint32_t last = NIL;
+    while (a != NIL && b != NIL) {
+        std::uint32_t& from = comp(data_[b], data_[a]) ? b : a;
+        std::uint32_t taken = from;
+        from = next_[from];
+        if (last == NIL) {
+            first = taken;
+        } else {
+            next_[last] = taken;
+        }
+        last = taken;
+    }
+    std::uint32_t rest = a != NIL ? a : b;
+    if (last == NIL) {
+        return rest;
+    }
+    next_[last] = rest;
+    return first;
+}
+
+template<typename T, typename Allocator>
+void structures::IndexLinkedList<T, Allocator>::relink() {
+    std::uint32_t previous = NIL;
+    for (std::uint32_t it = head; it != NIL; it = next_[it]) {
+        prev_[it] = previous;
+        previous = it;
+    }
+    tail = previous;
+}
+
+template<typename T, typename Allocator>
+template<typename Compare>
+void structures::IndexLinkedList<T, Allocator>::sort(Compare comp) {
+    if (size_ < 2u) {
+        return;
+    }
+    // bins[i] guarda um trecho ordenado de 2^i elementos (ou NIL)
+    std::uint32_t bins[32];
+    std::size_t fill = 0u;
+    std::uint32_t it = head;
+    while (it != NIL) {
+        std::uint32_t carry = it;
+        it = next_[it];
+        next_[carry] = NIL;
+        std::size_t i = 0u;
+        for (; i < fill && bins[i] != NIL; i++) {
+            carry = merge_runs(bins[i], carry, comp);
+            bins[i] = NIL;
+        }
+        bins[i] = carry;
+        if (i == fill) {
+            fill++;
+        }
+    }
+    std::uint32_t sorted = NIL;
+    for (std::size_t i = 0u; i < fill; i++) {
+        if (bins[i] != NIL) {
+            sorted = merge_runs(bins[i], sorted, comp);
+        }
+    }
+    head = sorted;
+    relink();
+}
+
+template<typename T, typename Allocator>
+template<typename Compare>
+void structures::IndexLinkedList<T, Allocator>::merge(IndexLinkedList& other,
+                                                      Compare comp) {
+    if (&other == this || other.empty()) {
+        return;
+    }
+    // indices so valem nos proprios vetores: copia o outro para o fim e
+    // intercala os dois trechos religando
+    std::uint32_t mine = head;
+    std::uint32_t old_tail = tail;
+    reserve(size_ + other.size_);
+    for (std::uint32_t it = other.head; it != NIL; it = other.next_[it]) {
+        push_back(other.data_[it]);
+    }
+    other.clear();
+    std::uint32_t theirs = head;
+    if (old_tail != NIL) {
+        theirs = next_[old_tail];
+        next_[old_tail] = NIL;
+    } else {
+        mine = NIL;
+    }
+    head = merge_runs(mine, theirs, comp);
+    relink();
+}
+
+template<typename T, typename Allocator>
+void structures::IndexLinkedList<T, Allocator>::compact() {
+    if (capacity_ > 0u) {
+        reallocate(capacity_, true);
+    }
+}
+
+template<typename T, typename Allocator>
+void structures::IndexLinkedList<T, Allocator>::reserve(
+    std::size_t capacity) {
+    if (capacity > NIL) {
+        throw std::out_of_range("the list is full");
+    }
+    if (capacity > capacity_) {
+        reallocate(capacity, false);
+    }
+}
+
+template<typename T, typename Allocator>
+bool structures::IndexLinkedList<T, Allocator>::empty() const {
+    return size_ == 0u;
+}
+
+template<typename T, typename Allocator>
+bool structures::IndexLinkedList<T, Allocator>::contains(
+    const T& data) const {
+    return find(data) != size_;
+}
+
+template<typename T, typename Allocator>
+T& structures::IndexLinkedList<T, Allocator>::at(std::size_t index) {
+    if (index >= size_) {
+        throw std::out_of_range("invalid index");
+    }
+    return data_[node_at(index)];
+}
+
+template<typename T, typename Allocator>
+const T& structures::IndexLinkedList<T, Allocator>::at(
+    std::size_t index) const {
+    if (index >= size_) {
+        throw std::out_of_range("invalid index");
+    }
+    return data_[node_at(index)];
+}
+
+template<typename T, typename Allocator>
+std::size_t structures::IndexLinkedList<T, Allocator>::find(
+    const T& data) const {
+    std::size_t index = 0u;
+    for (std::uint32_t it = head; it != NIL; it = next_[it]) {
+        if (data_[it] == data) {
+            return index;
+        }
+        index++;
+    }
+    return size_;
+}
+
+template<typename T, typename Allocator>
+std::size_t structures::IndexLinkedList<T, Allocator>::size() const {
+    return size_;
+}
+
+template<typename T, typename Allocator>
+std::size_t structures::IndexLinkedList<T, Allocator>::capacity() const {
+    return capacity_;
+}
+
+template<typename T, typename Allocator>
+Allocator structures::IndexLinkedList<T, Allocator>::get_allocator() const {
+    return alloc_;
+}
+
+template<typename T, typename Allocator>
+typename structures::IndexLinkedList<T, Allocator>::Cursor
+structures::IndexLinkedList<T, Allocator>::cursor(std::size_t index) {
+    if (index > size_) {
+        throw std::out_of_range("invalid index");
+    }
+    return Cursor(this, index == size_ ? NIL : node_at(index));
+}
+
+template<typename T, typename Allocator>
+T& structures::IndexLinkedList<T, Allocator>::Cursor::data() {
+    if (id_ == NIL) {
+        throw std::out_of_range("cursor at end");
+    }
+    return list_->data_[id_];
+}
+
+template<typename T, typename Allocator>
+bool structures::IndexLinkedList<T, Allocator>::Cursor::end() const {
+    return id_ == NIL;
+}
+
+template<typename T, typename Allocator>
+void structures::IndexLinkedList<T, Allocator>::Cursor::advance() {
+    if (id_ == NIL) {
+        throw std::out_of_range("cursor at end");
+    }
+    id_ = list_->next_[id_];
+}
+
+template<typename T, typename Allocator>
+void structures::IndexLinkedList<T, Allocator>::Cursor::retreat() {
+    std::uint32_t previous = id_ == NIL ? list_->tail : list_->prev_[id_];
+    if (previous == NIL) {
+        throw std::out_of_range("cursor at begin");
+    }
+    id_ = previous;
+}
+
+template<typename T, typename Allocator>
+void structures::IndexLinkedList<T, Allocator>::Cursor::
+insert_before(const T& data) {
+    list_->link_before(list_->acquire(data), id_);
+}
+
+template<typename T, typename Allocator>
+void structures::IndexLinkedList<T, Allocator>::Cursor::
+insert_after(const T& data) {
+    if (id_ == NIL) {
+        throw std::out_of_range("cursor at end");
+    }
+    list_->link_before(list_->acquire(data), list_->next_[id_]);
+}
+
+template<typename T, typename Allocator>
+T structures::IndexLinkedList<T, Allocator>::Cursor::erase() {
+    if (id_ == NIL) {
+        throw std::out_of_range("cursor at end");
+    }
+    std::uint32_t popped = id_;
+    id_ = list_->next_[popped];
+    list_->unlink(popped);
+    T data = std::move(list_->data_[popped]);
+    list_->release(popped);
+    return data;
+}
+
+#endif
@@ -1,11 +1,19 @@
 // Copyright [2023] <Claudio Gerolimetto>
 
+#include <functional>
+#include <memory>
+#include <memory_resource>
+#include <utility>
+
+#include "slab_allocator.h"
+
 namespace structures {
 
-template<typename T>
+template<typename T, typename Allocator = SlabAllocator<T>>
 class DoublyLinkedList {
  public:
     DoublyLinkedList();
+    explicit DoublyLinkedList(const Allocator& alloc);
     ~DoublyLinkedList();
     void clear();
 
@@ -19,6 +27,13 @@ class DoublyLinkedList {
     T pop_front();
     void remove(const T& data);
 
+    //! merge sort estavel religando os nodos (sem alocar)
+    template<typename Compare = std::less<T>>
+    void sort(Compare comp = Compare());
+    //! intercala other (ordenada) nesta lista (ordenada) em O(n + m)
+    template<typename Compare = std::less<T>>
+    void merge(DoublyLinkedList& other, Compare comp = Compare());
+
     bool empty() const;
     bool contains(const T& data) const;
 
@@ -28,6 +43,12 @@ class DoublyLinkedList {
     std::size_t find(const T& data) const;
     std::size_t size() const;
 
+    Allocator get_allocator() const;
+
+    class Cursor;
+    //! cursor na posicao index (index == size(): depois do ultimo)
+    Cursor cursor(std::size_t index = 0u);
+
  private:
     class Node {
      public:
@@ -84,45 +105,171 @@ class DoublyLinkedList {
         Node* next_{nullptr};
     };
 
-    Node* node_at(std::size_t index) {
+    using NodeAllocator =
+        typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+    using NodeTraits = std::allocator_traits<NodeAllocator>;
+
+    template<typename... Args>
+    Node* allocate_node(Args&&... args) {
+        Node* node = NodeTraits::allocate(alloc_, 1);
+        try {
+            NodeTraits::construct(alloc_, node, std::forward<Args>(args)...);
+        } catch (...) {
+            NodeTraits::deallocate(alloc_, node, 1);
+            throw;
+        }
+        return node;
+    }
+
+    void deallocate_node(Node* node) {
+        NodeTraits::destroy(alloc_, node);
+        NodeTraits::deallocate(alloc_, node, 1);
+    }
+
+    //! intercala dois trechos ligados por next; no empate vem o de a
+    template<typename Compare>
+    static Node* merge_runs(Node* a, Node* b, Compare& comp);
+    //! refaz prev e tail a partir de head depois de religar por next
+    void relink();
+
+    //! nodo na posicao index, andando a partir do mais perto entre
+    //! head, tail e o ultimo nodo acessado (finger); so le o finger, entao
+    //! leituras const concorrentes continuam seguras
+    Node* locate(std::size_t index) const {
         Node* it = head;
-        for (std::size_t i = 0; i < index; ++i) {
+        std::size_t from = 0;
+        std::size_t distance = index;
+        if (size_ - 1 - index < distance) {
+            it = tail;
+            from = size_ - 1;
+            distance = size_ - 1 - index;
+        }
+        if (finger_ != nullptr) {
+            std::size_t gap = finger_index_ > index ? finger_index_ - index
+                                                    : index - finger_index_;
+            if (gap < distance) {
+                it = finger_;
+                from = finger_index_;
+            }
+        }
+        for (; from < index; ++from) {
             it = it->next();
         }
+        for (; from > index; --from) {
+            it = it->prev();
+        }
         return it;
     }
 
+    //! locate que tambem move o finger para o nodo achado
+    Node* node_at(std::size_t index) {
+        Node* it = locate(index);
+        finger_ = it;
+        finger_index_ = index;
+        return it;
+    }
+
+    //! corrige o finger depois de inserir na posicao index
+    void finger_inserted(std::size_t index) {
+        if (finger_ != nullptr && finger_index_ >= index) {
+            finger_index_++;
+        }
+    }
+
+    //! corrige o finger depois de retirar a posicao index
+    void finger_erased(std::size_t index) {
+        if (finger_ != nullptr) {
+            if (finger_index_ == index) {
+                finger_ = nullptr;
+            } else if (finger_index_ > index) {
+                finger_index_--;
+            }
+        }
+    }
+
+    NodeAllocator alloc_{};
     Node* head{nullptr};
     Node* tail{nullptr};
     std::size_t size_{0u};
+    Node* finger_{nullptr};  // cache do ultimo node_at
+    std::size_t finger_index_{0u};
+
+ public:
+    //! posicao estavel na lista: editar em volta do cursor e O(1);
+    //! so fica invalido se o nodo dele for removido por outro caminho
+    class Cursor {
+     public:
+        //! dado na posicao atual
+        T& data();
+        //! true se esta depois do ultimo elemento
+        bool end() const;
+        //! vai para o proximo (do ultimo vai para end)
+        void advance();
+        //! volta para o anterior (de end volta para o ultimo)
+        void retreat();
+        //! insere antes da posicao atual (em end, insere no fim)
+        void insert_before(const T& data);
+        //! insere depois da posicao atual
+        void insert_after(const T& data);
+        //! retira o elemento atual; o cursor passa para o seguinte
+        T erase();
+
+     private:
+        friend class DoublyLinkedList;
+
+        Cursor(DoublyLinkedList* list, Node* node):
+            list_{list},
+            node_{node}
+        {}
+
+        DoublyLinkedList* list_;
+        Node* node_;  // nullptr = end
+    };
 };
 
-}  // namespace structures
+namespace pmr {
 
 template<typename T>
-structures::DoublyLinkedList<T>::DoublyLinkedList() {}
+using DoublyLinkedList =
+    structures::DoublyLinkedList<T, std::pmr::polymorphic_allocator<T>>;
 
-template<typename T>
-structures::DoublyLinkedList<T>::~DoublyLinkedList() {
+}  // namespace pmr
+
+}  // namespace structures
+
+template<typename T, typename Allocator>
+structures::DoublyLinkedList<T, Allocator>::DoublyLinkedList() {}
+
+template<typename T, typename Allocator>
+structures::DoublyLinkedList<T, Allocator>::
+DoublyLinkedList(const Allocator& alloc):
+    alloc_{alloc}
+{}
+
+template<typename T, typename Allocator>
+structures::DoublyLinkedList<T, Allocator>::~DoublyLinkedList() {
     clear();
 }
 
-template<typename T>
-void structures::DoublyLinkedList<T>::clear() {
+template<typename T, typename Allocator>
+void structures::DoublyLinkedList<T, Allocator>::clear() {
+    DeallocationBatch<NodeAllocator> batch(alloc_);
     Node* last = head;
     for (std::size_t i = 0; i < size_; i++) {
         Node* next = last->next();
-        delete last;
+        NodeTraits::destroy(alloc_, last);
+        batch.add(last);
         last = next;
     }
     head = nullptr;
     tail = nullptr;
     size_ = 0;
+    finger_ = nullptr;
 }
 
-template<typename T>
-void structures::DoublyLinkedList<T>::push_back(const T& data) {
-    Node* new_node = new Node(data);
+template<typename T, typename Allocator>
+void structures::DoublyLinkedList<T, Allocator>::push_back(const T& data) {
+    Node* new_node = allocate_node(data);
     if (size_ == 0) {
         head = new_node;
     } else {
@@ -133,32 +280,40 @@ void structures::DoublyLinkedList<T>::push_back(const T& data) {
     size_++;
 }
 
-template<typename T>
-void structures::DoublyLinkedList<T>::push_front(const T& data) {
-    Node* new_node = new Node(data, head);
+template<typename T, typename Allocator>
+void structures::DoublyLinkedList<T, Allocator>::push_front(const T& data) {
+    Node* new_node = allocate_node(data, head);
     if (size_ > 0) {
         head->prev(new_node);
+    } else {
+        tail = new_node;
     }
     head = new_node;
     size_++;
+    finger_inserted(0);
 }
 
-template<typename T>
-void structures::DoublyLinkedList<T>::insert(const T& data, std::size_t index) {
+template<typename T, typename Allocator>
+void structures::DoublyLinkedList<T, Allocator>::
+insert(const T& data, std::size_t index) {
     if (index < 0 || index > size_) {
         throw std::out_of_range("invalid index");
     } else if (index == 0) {
         push_front(data);
+    } else if (index == size_) {
+        push_back(data);
     } else {
         Node* current = node_at(index);
-        Node* new_node = new Node(data, current->prev(), current);
+        Node* new_node = allocate_node(data, current->prev(), current);
         current->prev()->next(new_node);
+        current->prev(new_node);
         size_++;
+        finger_inserted(index);
     }
 }
 
-template<typename T>
-void structures::DoublyLinkedList<T>::insert_sorted(const T& data) {
+template<typename T, typename Allocator>
+void structures::DoublyLinkedList<T, Allocator>::insert_sorted(const T& data) {
     Node* current = head;
 
     for (std::size_t i = 0; i < size_; i++) {
@@ -171,8 +326,8 @@ void structures::DoublyLinkedList<T>::insert_sorted(const T& data) {
     push_back(data);
 }
 
-template<typename T>
-T structures::DoublyLinkedList<T>::pop(std::size_t index) {
+template<typename T, typename Allocator>
+T structures::DoublyLinkedList<T, Allocator>::pop(std::size_t index) {
     if (size_ == 0) {
         throw std::out_of_range("the list is empty");
     }
@@ -186,67 +341,78 @@ T structures::DoublyLinkedList<T>::pop(std::size_t index) {
     Node* following = popped->next();
     if (following != nullptr) {
         following->prev(previous);
+    } else {
+        tail = previous;
     }
     previous->next(following);
 
     T data = popped->data();
-    delete popped;
+    deallocate_node(popped);
     size_--;
+    finger_erased(index);
     return data;
 }
 
-template<typename T>
-T structures::DoublyLinkedList<T>::pop_back() {
+template<typename T, typename Allocator>
+T structures::DoublyLinkedList<T, Allocator>::pop_back() {
     return pop(size_ - 1);
 }
 
-template<typename T>
-T structures::DoublyLinkedList<T>::pop_front() {
+template<typename T, typename Allocator>
+T structures::DoublyLinkedList<T, Allocator>::pop_front() {
     if (size_ == 0) {
         throw std::out_of_range("the list is empty");
     }
     T data = head->data();
     Node* new_head = head->next();
-    delete head;
+    deallocate_node(head);
     size_--;
+    finger_erased(0);
     head = new_head;
+    if (head != nullptr) {
+        head->prev(nullptr);
+    } else {
+        tail = nullptr;
+    }
     return data;
 }
 
-template<typename T>
-void structures::DoublyLinkedList<T>::remove(const T& data) {
+template<typename T, typename Allocator>
+void structures::DoublyLinkedList<T, Allocator>::remove(const T& data) {
     pop(find(data));
 }
 
 
-template<typename T>
-bool structures::DoublyLinkedList<T>::empty() const {
+template<typename T, typename Allocator>
+bool structures::DoublyLinkedList<T, Allocator>::empty() const {
     return size_ == 0;
 }
 
-template<typename T>
-bool structures::DoublyLinkedList<T>::contains(const T& data) const {
+template<typename T, typename Allocator>
+bool structures::DoublyLinkedList<T, Allocator>::contains(const T& data) const {
     return find(data) != size_;
 }
 
-template<typename T>
-T& structures::DoublyLinkedList<T>::at(std::size_t index) {
+template<typename T, typename Allocator>
+T& structures::DoublyLinkedList<T, Allocator>::at(std::size_t index) {
     if (index < 0 || index >= size_) {
         throw std::out_of_range("invalid index");
     }
     return node_at(index)->data();
 }
 
-template<typename T>
-const T& structures::DoublyLinkedList<T>::at(std::size_t index) const {
+template<typename T, typename Allocator>
+const T& structures::DoublyLinkedList<T, Allocator>::
+at(std::size_t index) const {
     if (index < 0 || index >= size_) {
         throw std::out_of_range("invalid index");
     }
-    return node_at(index)->data();
+    return locate(index)->data();
 }
 
-template<typename T>
-std::size_t structures::DoublyLinkedList<T>::find(const T& data) const {
+template<typename T, typename Allocator>
+std::size_t structures::DoublyLinkedList<T, Allocator>::
+find(const T& data) const {
     Node* current = head;
     for (std::size_t i = 0; i < size_; i++) {
         if (data == current->data()) {
@@ -257,7 +423,208 @@ std::size_t structures::DoublyLinkedList<T>::find(const T& data) const {
     return size_;
 }
 
-template<typename T>
-std::size_t structures::DoublyLinkedList<T>::size() const {
+template<typename T, typename Allocator>
+std::size_t structures::DoublyLinkedList<T, Allocator>::size() const {
     return size_;
 }
+
+template<typename T, typename Allocator>
+Allocator structures::DoublyLinkedList<T, Allocator>::get_allocator() const {
+    return Allocator(alloc_);
+}
+
+template<typename T, typename Allocator>
+template<typename Compare>
+typename structures::DoublyLinkedList<T, Allocator>::Node*
+structures::DoublyLinkedList<T, Allocator>::merge_runs(Node* a, Node* b,
+                                                       Compare& comp) {
+    Node* first = nullptr;
+    Node* last = nullptr;
+    while (a != nullptr && b != nullptr) {
+        Node*& from = comp(b->data(), a->data()) ? b : a;
+        Node* taken = from;
+        from = from->next();
+        if (last == nullptr) {
+            first = taken;
+        } else {
+            last->next(taken);
+        }
+        last = taken;
+    }
+    Node* rest = a != nullptr ? a : b;
+    if (last == nullptr) {
+        return rest;
+    }
+    last->next(rest);
+    return first;
+}
+
+template<typename T, typename Allocator>
+void structures::DoublyLinkedList<T, Allocator>::relink() {
+    Node* previous = nullptr;
+    for (Node* it = head; it != nullptr; it = it->next()) {
+        it->prev(previous);
+        previous = it;
+    }
+    tail = previous;
+}
+
+template<typename T, typename Allocator>
+template<typename Compare>
+void structures::DoublyLinkedList<T, Allocator>::sort(Compare comp) {
+    if (size_ < 2) {
+        return;
+    }
+    // bins[i]: trecho ordenado com 2^i nodos; os mais altos sao os mais
+    // antigos e entram como primeiro argumento, o que mantem a estabilidade
+    Node* bins[64] = {};
+    std::size_t fill = 0;
+    Node* it = head;
+    while (it != nullptr) {
+        Node* carry = it;
+        it = it->next();
+        carry->next(nullptr);
+        std::size_t i = 0;
+        for (; i < fill && bins[i] != nullptr; i++) {
+            carry = merge_runs(bins[i], carry, comp);
+            bins[i] = nullptr;
+        }
+        bins[i] = carry;
+        if (i == fill) {
+            fill++;
+        }
+    }
+    Node* sorted = nullptr;
+    for (std::size_t i = 0; i < fill; i++) {
+        if (bins[i] != nullptr) {
+            sorted = merge_runs(bins[i], sorted, comp);
+        }
+    }
+    head = sorted;
+    finger_ = nullptr;
+    relink();
+}
+
+template<typename T, typename Allocator>
+template<typename Compare>
+void structures::DoublyLinkedList<T, Allocator>::merge(DoublyLinkedList& other,
+                                                       Compare comp) {
+    if (&other == this || other.empty()) {
+        return;
+    }
+    if (!(alloc_ == other.alloc_)) {
+        // nodos nao podem mudar de alocador: copia e reordena
+        for (Node* it = other.head; it != nullptr; it = it->next()) {
+            push_back(it->data());
+        }
+        other.clear();
+        sort(comp);
+        return;
+    }
+    head = merge_runs(head, other.head, comp);
+    size_ += other.size_;
+    other.head = nullptr;
+    other.tail = nullptr;
+    other.size_ = 0;
+    other.finger_ = nullptr;
+    finger_ = nullptr;
+    relink();
+}
+
+template<typename T, typename Allocator>
+typename structures::DoublyLinkedList<T, Allocator>::Cursor
+structures::DoublyLinkedList<T, Allocator>::cursor(std::size_t index) {
+    if (index > size_) {
+        throw std::out_of_range("invalid index");
+    }
+    return Cursor(this, index == size_ ? nullptr : node_at(index));
+}
+
+template<typename T, typename Allocator>
+T& structures::DoublyLinkedList<T, Allocator>::Cursor::data() {
+    if (node_ == nullptr) {
+        throw std::out_of_range("cursor at end");
+    }
+    return node_->data();
+}
+
+template<typename T, typename Allocator>
+bool structures::DoublyLinkedList<T, Allocator>::Cursor::end() const {
+    return node_ == nullptr;
+}
+
+template<typename T, typename Allocator>
+void structures::DoublyLinkedList<T, Allocator>::Cursor::advance() {
+    if (node_ == nullptr) {
+        throw std::out_of_range("cursor at end");
+    }
+    node_ = node_->next();
+}
+
+template<typename T, typename Allocator>
+void structures::DoublyLinkedList<T, Allocator>::Cursor::retreat() {
+    Node* previous = node_ == nullptr ? list_->tail : node_->prev();
+    if (previous == nullptr) {
+        throw std::out_of_range("cursor at begin");
+    }
+    node_ = previous;
+}
+
+template<typename T, typename Allocator>
+void structures::DoublyLinkedList<T, Allocator>::Cursor::
+insert_before(const T& data) {
+    if (node_ == nullptr) {
+        list_->push_back(data);
+    } else if (node_ == list_->head) {
+        list_->push_front(data);
+    } else {
+        Node* new_node = list_->allocate_node(data, node_->prev(), node_);
+        node_->prev()->next(new_node);
+        node_->prev(new_node);
+        list_->size_++;
+        list_->finger_ = nullptr;
+    }
+}
+
+template<typename T, typename Allocator>
+void structures::DoublyLinkedList<T, Allocator>::Cursor::
+insert_after(const T& data) {
+    if (node_ == nullptr) {
+        throw std::out_of_range("cursor at end");
+    }
+    if (node_ == list_->tail) {
+        list_->push_back(data);
+    } else {
+        Node* new_node = list_->allocate_node(data, node_, node_->next());
+        node_->next()->prev(new_node);
+        node_->next(new_node);
+        list_->size_++;
+        list_->finger_ = nullptr;
+    }
+}
+
+template<typename T, typename Allocator>
+T structures::DoublyLinkedList<T, Allocator>::Cursor::erase() {
+    if (node_ == nullptr) {
+        throw std::out_of_range("cursor at end");
+    }
+    Node* popped = node_;
+    Node* previous = popped->prev();
+    Node* following = popped->next();
+    if (previous == nullptr) {
+        list_->head = following;
+    } else {
+        previous->next(following);
+    }
+    if (following == nullptr) {
+        list_->tail = previous;
+    } else {
+        following->prev(previous);
+    }
+    T data = popped->data();
+    list_->deallocate_node(popped);
+    list_->size_--;
+    list_->finger_ = nullptr;
+    node_ = following;
+    return data;
+}
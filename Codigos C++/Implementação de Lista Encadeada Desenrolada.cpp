@@ -0,0 +1,413 @@
+#ifndef STRUCTURES_UNROLLED_LINKED_LIST_H
+#define STRUCTURES_UNROLLED_LINKED_LIST_H
+
+#include <cstdint>  // std::size_t
+#include <memory>  // std::allocator_traits
+#include <memory_resource>  // std::pmr::polymorphic_allocator
+#include <stdexcept>  // C++ exceptions
+#include <utility>  // std::move
+
+#include "slab_allocator.h"
+
+namespace structures {
+
+template<typename T, typename Allocator = SlabAllocator<T>>
+//! lista encadeada desenrolada: cada nodo guarda um vetor pequeno de
+//! elementos (cerca de 128 bytes), dividido quando enche e fundido com
+//! o vizinho quando esvazia; mesma interface da LinkedList
+class UnrolledLinkedList {
+ public:
+    UnrolledLinkedList();
+    explicit UnrolledLinkedList(const Allocator& alloc);
+    ~UnrolledLinkedList();
+    UnrolledLinkedList(const UnrolledLinkedList&) = delete;
+    UnrolledLinkedList& operator=(const UnrolledLinkedList&) = delete;
+    void clear();
+
+    void push_back(const T& data);
+    void push_front(const T& data);
+    void insert(const T& data, std::size_t index);
+    void insert_sorted(const T& data);
+
+    T pop(std::size_t index);
+    T pop_back();
+    T pop_front();
+    void remove(const T& data);
+
+    void splice(UnrolledLinkedList& other);
+    void append(UnrolledLinkedList&& other);
+
+    bool empty() const;
+    bool contains(const T& data) const;
+
+    T& at(std::size_t index);
+    const T& at(std::size_t index) const;
+    T& back();
+
+    std::size_t find(const T& data) const;
+    std::size_t size() const;
+
+    Allocator get_allocator() const;
+
+ private:
+    //! elementos por nodo: enche cerca de duas linhas de cache
+    static const std::size_t CAPACITY =
+        sizeof(T) * 4u >= 112u ? 4u : 112u / sizeof(T);
+
+    struct Node {
+        Node* next{nullptr};
+        std::size_t count{0u};
+        T contents[CAPACITY];
+    };
+
+    using NodeAllocator =
+        typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+    using NodeTraits = std::allocator_traits<NodeAllocator>;
+
+    Node* allocate_node();
+    void deallocate_node(Node* node);
+    //! nodo que contem a posicao index; index vira a posicao no nodo
+    Node* locate(std::size_t& index) const;
+    //! move a metade de cima de node para um nodo novo logo depois dele
+    void split(Node* node);
+    //! retira node (ja vazio) da lista; prev e o nodo anterior ou nullptr
+    void unlink(Node* prev, Node* node);
+
+    NodeAllocator alloc_{};
+    Node* head{nullptr};
+    Node* tail{nullptr};
+    std::size_t size_{0u};
+};
+
+namespace pmr {
+
+template<typename T>
+using UnrolledLinkedList =
+    structures::UnrolledLinkedList<T, std::pmr::polymorphic_allocator<T>>;
+
+}  // namespace pmr
+
+}  // namespace structures
+
+template<typename T, typename Allocator>
+structures::UnrolledLinkedList<T, Allocator>::UnrolledLinkedList() {}
+
+template<typename T, typename Allocator>
+structures::UnrolledLinkedList<T, Allocator>::
+UnrolledLinkedList(const Allocator& alloc):
+    alloc_{alloc}
+{}
+
+template<typename T, typename Allocator>
+structures::UnrolledLinkedList<T, Allocator>::~UnrolledLinkedList() {
+    clear();
+}
+
+template<typename T, typename Allocator>
+typename structures::UnrolledLinkedList<T, Allocator>::Node*
+structures::UnrolledLinkedList<T, Allocator>::allocate_node() {
+    Node* node = NodeTraits::allocate(alloc_, 1);
+    try {
+        NodeTraits::construct(alloc_, node);
+    } catch (...) {
+        NodeTraits::deallocate(alloc_, node, 1);
+        throw;
+    }
+    return node;
+}
+
+template<typename T, typename Allocator>
+void structures::UnrolledLinkedList<T, Allocator>::
+deallocate_node(Node* node) {
+    NodeTraits::destroy(alloc_, node);
+    NodeTraits::deallocate(alloc_, node, 1);
+}
+
+template<typename T, typename Allocator>
+void structures::UnrolledLinkedList<T, Allocator>::clear() {
+    DeallocationBatch<NodeAllocator> batch(alloc_);
+    while (head != nullptr) {
+        Node* next = head->next;
+        NodeTraits::destroy(alloc_, head);
+        batch.add(head);
+        head = next;
+    }
+    tail = nullptr;
+    size_ = 0u;
+}
+
+template<typename T, typename Allocator>
+typename structures::UnrolledLinkedList<T, Allocator>::Node*
+structures::UnrolledLinkedList<T, Allocator>::locate(
+    std::size_t& index) const {
+    Node* node = head;
+    while (index >= node->count) {
+        index -= node->count;
+        node = node->next;
+    }
+    return node;
+}
+
+template<typename T, typename Allocator>
+void structures::UnrolledLinkedList<T, Allocator>::split(Node* node) {
+    Node* novo = allocate_node();
+    std::size_t half = node->count / 2u;
+    for (std::size_t i = half; i < node->count; i++) {
+        novo->contents[i - half] = std::move(node->contents[i]);
+    }
+    novo->count = node->count - half;
+    node->count = half;
+    novo->next = node->next;
+    node->next = novo;
+    if (tail == node) {
+        tail = novo;
+    }
+}
+
+template<typename T, typename Allocator>
+void structures::UnrolledLinkedList<T, Allocator>::unlink(Node* prev,
+                                                          Node* node) {
+    if (prev == nullptr) {
+        head = node->next;
+    } else {
+        prev->next = node->next;
+    }
+    if (tail == node) {
+        tail = prev;
+    }
+    deallocate_node(node);
+}
+
+template<typename T, typename Allocator>
+void structures::UnrolledLinkedList<T, Allocator>::push_back(const T& data) {
+    if (tail == nullptr || tail->count == CAPACITY) {
+        // nodo novo em vez de dividir: insercoes no fim enchem os nodos
+        Node* novo = allocate_node();
+        if (tail == nullptr) {
+            head = novo;
+        } else {
+            tail->next = novo;
+        }
+        tail = novo;
+    }
+    tail->contents[tail->count] = data;
+    tail->count++;
+    size_++;
+}
+
+template<typename T, typename Allocator>
+void structures::UnrolledLinkedList<T, Allocator>::push_front(const T& data) {
+    if (head == nullptr || head->count == CAPACITY) {
+        Node* novo = allocate_node();
+        novo->next = head;
+        head = novo;
+        if (tail == nullptr) {
+            tail = novo;
+        }
+    }
+    for (std::size_t i = head->count; i > 0u; i--) {
+        head->contents[i] = std::move(head->contents[i - 1u]);
+    }
+    head->contents[0] = data;
+    head->count++;
+    size_++;
+}
+
+template<typename T, typename Allocator>
+void structures::UnrolledLinkedList<T, Allocator>::insert(const T& data,
+                                                          std::size_t index) {
+    if (index > size_) {
+        throw std::out_of_range("ERRO NA POSIÇÃO!!!");
+    }
+    if (index == size_) {
+        push_back(data);
+        return;
+    }
+    Node* node = locate(index);
+    if (node->count == CAPACITY) {
+        split(node);
+        if (index > node->count) {
+            index -= node->count;
+            node = node->next;
+        }
+    }
+    for (std::size_t i = node->count; i > index; i--) {
+        node->contents[i] = std::move(node->contents[i - 1u]);
+    }
+    node->contents[index] = data;
+    node->count++;
+    size_++;
+}
+
+template<typename T, typename Allocator>
+void structures::UnrolledLinkedList<T, Allocator>::insert_sorted(
+    const T& data) {
+    std::size_t pos = 0u;
+    for (Node* node = head; node != nullptr; node = node->next) {
+        for (std::size_t i = 0u; i < node->count; i++) {
+            if (!(data > node->contents[i])) {
+                insert(data, pos);
+                return;
+            }
+            pos++;
+        }
+    }
+    push_back(data);
+}
+
+template<typename T, typename Allocator>
+T structures::UnrolledLinkedList<T, Allocator>::pop(std::size_t index) {
+    if (empty()) {
+        throw std::out_of_range("LISTA VAZIA!!!");
+    }
+    if (index >= size_) {
+        throw std::out_of_range("ERRO NA POSIÇÃO!!!");
+    }
+    Node* prev = nullptr;
+    Node* node = head;
+    while (index >= node->count) {
+        index -= node->count;
+        prev = node;
+        node = node->next;
+    }
+    T back = std::move(node->contents[index]);
+    for (std::size_t i = index + 1u; i < node->count; i++) {
+        node->contents[i - 1u] = std::move(node->contents[i]);
+    }
+    node->count--;
+    size_--;
+    if (node->count == 0u) {
+        unlink(prev, node);
+    } else if (node->count < CAPACITY / 2u && node->next != nullptr &&
+               node->count + node->next->count <= CAPACITY) {
+        // nodo ficou magro: absorve o seguinte para manter a densidade
+        Node* next = node->next;
+        for (std::size_t i = 0u; i < next->count; i++) {
+            node->contents[node->count + i] = std::move(next->contents[i]);
+        }
+        node->count += next->count;
+        next->count = 0u;
+        unlink(node, next);
+    }
+    return back;
+}
+
+template<typename T, typename Allocator>
+T structures::UnrolledLinkedList<T, Allocator>::pop_back() {
+    if (empty()) {
+        throw std::out_of_range("LISTA VAZIA!!!");
+    }
+    return pop(size_ - 1u);
+}
+
+template<typename T, typename Allocator>
+T structures::UnrolledLinkedList<T, Allocator>::pop_front() {
+    if (empty()) {
+        throw std::out_of_range("LISTA VAZIA!!!");
+    }
+    return pop(0u);
+}
+
+template<typename T, typename Allocator>
+void structures::UnrolledLinkedList<T, Allocator>::remove(const T& data) {
+    pop(find(data));
+}
+
+template<typename T, typename Allocator>
+void structures::UnrolledLinkedList<T, Allocator>::splice(
+    UnrolledLinkedList& other) {
+    if (&other == this || other.empty()) {
+        return;
+    }
+    if (!(alloc_ == other.alloc_)) {
+        for (Node* node = other.head; node != nullptr; node = node->next) {
+            for (std::size_t i = 0u; i < node->count; i++) {
+                push_back(node->contents[i]);
+            }
+        }
+        other.clear();
+        return;
+    }
+    if (empty()) {
+        head = other.head;
+    } else {
+        tail->next = other.head;
+    }
+    tail = other.tail;
+    size_ += other.size_;
+    other.head = nullptr;
+    other.tail = nullptr;
+    other.size_ = 0u;
+}
+
+template<typename T, typename Allocator>
+void structures::UnrolledLinkedList<T, Allocator>::append(
+    UnrolledLinkedList&& other) {
+    splice(other);
+}
+
+template<typename T, typename Allocator>
+bool structures::UnrolledLinkedList<T, Allocator>::empty() const {
+    return size_ == 0u;
+}
+
+template<typename T, typename Allocator>
+bool structures::UnrolledLinkedList<T, Allocator>::contains(
+    const T& data) const {
+    return find(data) != size_;
+}
+
+template<typename T, typename Allocator>
+T& structures::UnrolledLinkedList<T, Allocator>::at(std::size_t index) {
+    if (index >= size_) {
+        throw std::out_of_range("POSIÇÃO INVÁLIDA!!!");
+    }
+    Node* node = locate(index);
+    return node->contents[index];
+}
+
+template<typename T, typename Allocator>
+const T& structures::UnrolledLinkedList<T, Allocator>::at(
+    std::size_t index) const {
+    if (index >= size_) {
+        throw std::out_of_range("POSIÇÃO INVÁLIDA!!!");
+    }
+    const Node* node = locate(index);
+    return node->contents[index];
+}
+
+template<typename T, typename Allocator>
+T& structures::UnrolledLinkedList<T, Allocator>::back() {
+    if (empty()) {
+        throw std::out_of_range("LISTA VAZIA!!!");
+    }
+    return tail->contents[tail->count - 1u];
+}
+
+template<typename T, typename Allocator>
+std::size_t structures::UnrolledLinkedList<T, Allocator>::find(
+    const T& data) const {
+    // varre vetores contiguos: um acesso a memoria por nodo, nao por dado
+    std::size_t pos = 0u;
+    for (const Node* node = head; node != nullptr; node = node->next) {
+        for (std::size_t i = 0u; i < node->count; i++) {
+            if (node->contents[i] == data) {
+                return pos + i;
+            }
+        }
+        pos += node->count;
+    }
+    return size_;
+}
+
+template<typename T, typename Allocator>
+std::size_t structures::UnrolledLinkedList<T, Allocator>::size() const {
+    return size_;
+}
+
+template<typename T, typename Allocator>
+Allocator structures::UnrolledLinkedList<T, Allocator>::get_allocator() const {
+    return Allocator(alloc_);
+}
+
+#endif
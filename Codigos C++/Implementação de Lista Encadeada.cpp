@@ -2,43 +2,66 @@
 #define STRUCTURES_LINKED_LIST_H
 
 #include <cstdint>
+#include <functional>
+#include <memory>
+#include <memory_resource>
+#include <utility>
+
+#include "slab_allocator.h"
 
 
 namespace structures {
 
 //! ...
-template<typename T>
+template<typename T, typename Allocator = SlabAllocator<T>>
 class LinkedList {
  public:
     //! ...
 
     LinkedList() {}  // construtor padrão
 
+    explicit LinkedList(const Allocator& alloc):  // construtor com alocador
+        alloc_{alloc}
+    {}
+
     ~LinkedList() {  // destrutor
         clear();
     }
     void
-     clear() {  // limpar lista
-        while (!empty())
-            pop_front();
+     clear() {  // limpar lista: devolve os nodos sem copiar os dados
+        DeallocationBatch<NodeAllocator> batch(alloc_);  // uma devolucao so
+        while (head != nullptr) {
+            Node* next = head -> next();
+            NodeTraits::destroy(alloc_, head);
+            batch.add(head);
+            head = next;
+        }
+        tail = nullptr;
+        size_ = 0u;
     }
 
-    void push_back(const T& data) {  // inserir no fim
+    void push_back(const T& data) {  // inserir no fim, O(1) pela cauda
         if (empty()) {
             push_front(data);
         } else {
-            insert(data, size());
+            Node *novo = allocate_node(data);
+            tail -> next(novo);
+            tail = novo;
+            size_++;
         }
     }
 
     void push_front(const T& data) {  // inserir no início
-        Node *novo = new Node(data);  //  auxiliar.
+        Node *novo = allocate_node(data);  //  auxiliar.
         if (novo == nullptr) {
             throw std::out_of_range("ERRO LISTA CHEIA!!!");
         }
 
         novo-> next(head);
         head = novo;
+        if (tail == nullptr) {
+            tail = novo;
+        }
         size_++;
     }
 
@@ -49,9 +72,11 @@ class LinkedList {
 
         if (index == 0) {
             push_front(data);
+        } else if (index == size_) {
+            push_back(data);
         } else {
             Node *novo, *last;  //   auxiliares
-            novo = new Node(data);
+            novo = allocate_node(data);
 
             if (novo == nullptr)
                 throw std::out_of_range("ERRO LISTA CHEIA!!!");
@@ -116,8 +141,11 @@ class LinkedList {
         Node *kick = last -> next();
         T back = kick -> data();
         last -> next(kick -> next());
+        if (kick == tail) {
+            tail = last;
+        }
         size_--;
-        delete kick;
+        deallocate_node(kick);
         return back;
     }
 
@@ -132,11 +160,102 @@ class LinkedList {
         auto saiu = head;
         T back = saiu -> data();
         head = saiu -> next();
+        if (head == nullptr) {
+            tail = nullptr;
+        }
         size_--;
-        delete saiu;
+        deallocate_node(saiu);
         return back;
     }
 
+    T& back() {  //  último elemento, O(1)
+        if (empty()) {
+            throw std::out_of_range("LISTA VAZIA!!!");
+        }
+        return tail -> data();
+    }
+
+    void splice(LinkedList& other) {  //  move os nodos de other para o fim
+        if (&other == this || other.empty()) {
+            return;
+        }
+        if (!(alloc_ == other.alloc_)) {
+            // alocadores diferentes: os nodos nao podem mudar de dono
+            for (Node* it = other.head; it != nullptr; it = it -> next()) {
+                push_back(it -> data());
+            }
+            other.clear();
+            return;
+        }
+        if (empty()) {
+            head = other.head;
+        } else {
+            tail -> next(other.head);
+        }
+        tail = other.tail;
+        size_ += other.size_;
+        other.head = nullptr;
+        other.tail = nullptr;
+        other.size_ = 0u;
+    }
+
+    void append(LinkedList&& other) {  //  concatena other no fim
+        splice(other);
+    }
+
+    template<typename Compare = std::less<T>>
+    void sort(Compare comp = Compare()) {  //  merge sort estável, sem alocar
+        if (size_ < 2u) {
+            return;
+        }
+        // bins[i]: trecho ordenado com 2^i nodos; bins mais altos têm os
+        // nodos mais antigos, então o merge sempre os põe na frente
+        Node* bins[64] = {};
+        std::size_t fill = 0u;
+        Node* it = head;
+        while (it != nullptr) {
+            Node* carry = it;
+            it = it -> next();
+            carry -> next(nullptr);
+            std::size_t i = 0u;
+            for (; i < fill && bins[i] != nullptr; i++) {
+                carry = merge_runs(bins[i], carry, comp);
+                bins[i] = nullptr;
+            }
+            bins[i] = carry;
+            if (i == fill) {
+                fill++;
+            }
+        }
+        Node* sorted = nullptr;
+        for (std::size_t i = 0u; i < fill; i++) {
+            if (bins[i] != nullptr) {
+                sorted = merge_runs(bins[i], sorted, comp);
+            }
+        }
+        head = sorted;
+        fix_tail();
+    }
+
+    template<typename Compare = std::less<T>>
+    void merge(LinkedList& other, Compare comp = Compare()) {  //  O(n + m)
+        if (&other == this || other.empty()) {
+            return;
+        }
+        if (!(alloc_ == other.alloc_)) {
+            // nodos não podem mudar de alocador: copia e reordena
+            splice(other);
+            sort(comp);
+            return;
+        }
+        head = merge_runs(head, other.head, comp);
+        size_ += other.size_;
+        other.head = nullptr;
+        other.tail = nullptr;
+        other.size_ = 0u;
+        fix_tail();
+    }
+
     void remove(const T& data)  {   //   remover específico
         pop(find(data));
     }
@@ -166,6 +285,19 @@ class LinkedList {
         return size_;
     }
 
+    Allocator get_allocator() const {  //  alocador dos nodos
+        return Allocator(alloc_);
+    }
+
+    class Cursor;
+
+    Cursor cursor(std::size_t index = 0u) {  //  cursor na posição index
+        if (index > size()) {
+            throw std::out_of_range("ERRO NA POSIÇÃO!!!");
+        }
+        return Cursor(this, index == 0u ? nullptr : end(index));
+    }
+
  private:
     class Node {  // Elemento
      public:
@@ -203,6 +335,57 @@ class LinkedList {
         Node* next_{nullptr};
     };
 
+    using NodeAllocator =
+        typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+    using NodeTraits = std::allocator_traits<NodeAllocator>;
+
+    template<typename... Args>
+    Node* allocate_node(Args&&... args) {  // aloca nodo pelo alocador
+        Node* node = NodeTraits::allocate(alloc_, 1);
+        try {
+            NodeTraits::construct(alloc_, node, std::forward<Args>(args)...);
+        } catch (...) {
+            NodeTraits::deallocate(alloc_, node, 1);
+            throw;
+        }
+        return node;
+    }
+
+    void deallocate_node(Node* node) {  // devolve nodo ao alocador
+        NodeTraits::destroy(alloc_, node);
+        NodeTraits::deallocate(alloc_, node, 1);
+    }
+
+    template<typename Compare>
+    static Node* merge_runs(Node* a, Node* b, Compare& comp) {  // intercala
+        Node* first = nullptr;
+        Node* last = nullptr;
+        while (a != nullptr && b != nullptr) {
+            Node*& from = comp(b -> data(), a -> data()) ? b : a;  // empate: a
+            Node* taken = from;
+            from = from -> next();
+            if (last == nullptr) {
+                first = taken;
+            } else {
+                last -> next(taken);
+            }
+            last = taken;
+        }
+        Node* rest = a != nullptr ? a : b;
+        if (last == nullptr) {
+            return rest;
+        }
+        last -> next(rest);
+        return first;
+    }
+
+    void fix_tail() {  // reencontra a cauda depois de religar os nodos
+        tail = head;
+        while (tail != nullptr && tail -> next() != nullptr) {
+            tail = tail -> next();
+        }
+    }
+
     Node* end(std::size_t index) {  // último nodo da lista
         auto it = head;
         for (auto i = 1u; i < index; ++i) {
@@ -211,10 +394,109 @@ class LinkedList {
         return it;
     }
 
+    NodeAllocator alloc_{};
     Node* head{nullptr};
+    Node* tail{nullptr};  // último nodo, para push_back em O(1)
     std::size_t size_{0u};
+
+ public:
+    //! posição estável na lista; guarda o nodo anterior, então inserir
+    //! antes, inserir depois, remover e avançar são O(1). Sem retreat:
+    //! voltar numa lista simples exigiria percorrer desde head.
+    class Cursor {
+     public:
+        T& data() {  //  dado na posição atual
+            Node* node = current();
+            if (node == nullptr) {
+                throw std::out_of_range("CURSOR NO FIM!!!");
+            }
+            return node -> data();
+        }
+
+        bool end() const {  //  depois do último elemento
+            return current() == nullptr;
+        }
+
+        void advance() {  //  vai para o próximo
+            Node* node = current();
+            if (node == nullptr) {
+                throw std::out_of_range("CURSOR NO FIM!!!");
+            }
+            prev_ = node;
+        }
+
+        void insert_before(const T& data) {  //  insere antes do atual
+            if (prev_ == nullptr) {
+                list_ -> push_front(data);
+                prev_ = list_ -> head;
+            } else if (prev_ == list_ -> tail) {
+                list_ -> push_back(data);
+                prev_ = list_ -> tail;
+            } else {
+                Node* novo = list_ -> allocate_node(data, prev_ -> next());
+                prev_ -> next(novo);
+                prev_ = novo;
+                list_ -> size_++;
+            }
+        }
+
+        void insert_after(const T& data) {  //  insere depois do atual
+            Node* node = current();
+            if (node == nullptr) {
+                throw std::out_of_range("CURSOR NO FIM!!!");
+            }
+            Node* novo = list_ -> allocate_node(data, node -> next());
+            node -> next(novo);
+            if (list_ -> tail == node) {
+                list_ -> tail = novo;
+            }
+            list_ -> size_++;
+        }
+
+        T erase() {  //  retira o atual; o cursor fica no seguinte
+            Node* node = current();
+            if (node == nullptr) {
+                throw std::out_of_range("CURSOR NO FIM!!!");
+            }
+            if (prev_ == nullptr) {
+                list_ -> head = node -> next();
+            } else {
+                prev_ -> next(node -> next());
+            }
+            if (list_ -> tail == node) {
+                list_ -> tail = prev_;
+            }
+            T back = node -> data();
+            list_ -> deallocate_node(node);
+            list_ -> size_--;
+            return back;
+        }
+
+     private:
+        friend class LinkedList;
+
+        Cursor(LinkedList* list, Node* prev):
+            list_{list},
+            prev_{prev}
+        {}
+
+        Node* current() const {  //  nodo atual (nullptr no fim)
+            return prev_ == nullptr ? list_ -> head : prev_ -> next();
+        }
+
+        LinkedList* list_;
+        Node* prev_;  // nodo antes do atual; nullptr = início
+    };
 };
 
+namespace pmr {
+
+template<typename T>
+using LinkedList =
+    structures::LinkedList<T, std::pmr::polymorphic_allocator<T>>;
+
+}  // namespace pmr
+
 }  // namespace structures
 
 #endif
@@ -0,0 +1,412 @@
+#ifndef STRUCTURES_INTRUSIVE_LIST_H
+#define STRUCTURES_INTRUSIVE_LIST_H
+
+#include <cstddef>  // std::ptrdiff_t
+#include <cstdint>  // std::size_t
+#include <iterator>  // std::forward_iterator_tag
+#include <stdexcept>  // C++ exceptions
+
+namespace structures {
+
+template<typename T>
+class ListHook;
+
+template<typename T, ListHook<T> T::*Hook>
+class IntrusiveList;
+
+template<typename T>
+//! ligacoes embutidas em T; um gancho por lista da qual o objeto pode
+//! participar ao mesmo tempo (ex.: ListHook<T> por_idade, por_dono)
+class ListHook {
+ public:
+    ListHook() = default;
+    //! copiar o objeto nao copia suas ligacoes
+    ListHook(const ListHook&) {}
+    ListHook& operator=(const ListHook&) { return *this; }
+
+    //! true se o objeto esta ligado em alguma lista por este gancho
+    bool linked() const { return linked_; }
+
+ private:
+    template<typename U, ListHook<U> U::*H>
+    friend class IntrusiveList;
+
+    T* prev_{nullptr};
+    T* next_{nullptr};
+    bool linked_{false};
+};
+
+template<typename T, ListHook<T> T::*Hook>
+//! lista duplamente encadeada que liga os proprios objetos pelo membro
+//! Hook: nao aloca nem copia; os objetos nao pertencem a lista e devem
+//! sobreviver enquanto estiverem ligados
+class IntrusiveList {
+ public:
+    class iterator;
+
+    IntrusiveList();
+    ~IntrusiveList();
+    IntrusiveList(const IntrusiveList&) = delete;
+    IntrusiveList& operator=(const IntrusiveList&) = delete;
+    //! desliga todos os objetos
+    void clear();
+
+    //! data nao pode estar ligada em outra lista pelo mesmo Hook
+    //! (out_of_range se estiver)
+    void push_back(T& data);
+    void push_front(T& data);
+    void insert(T& data, std::size_t index);
+    void insert_sorted(T& data);
+
+    T& pop(std::size_t index);
+    T& pop_back();
+    T& pop_front();
+    //! desliga data em O(1); out_of_range se data nao estiver ligada
+    //! (ligada em outra lista pelo mesmo Hook e erro nao detectado)
+    void remove(T& data);
+
+    //! move os objetos de other para o fim desta em O(1)
+    void splice(IntrusiveList& other);
+    void swap(IntrusiveList& other);
+
+    bool empty() const;
+    bool contains(const T& data) const;
+
+    T& at(std::size_t index);
+    const T& at(std::size_t index) const;
+    T& front();
+    T& back();
+
+    std::size_t find(const T& data) const;
+    std::size_t size() const;
+
+    iterator begin();
+    iterator end();
+
+    class iterator {
+     public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = T*;
+        using reference = T&;
+
+        iterator() = default;
+        reference operator*() const { return *node_; }
+        pointer operator->() const { return node_; }
+        iterator& operator++() {
+            node_ = (node_->*Hook).next_;
+            return *this;
+        }
+        iterator operator++(int) {
+            iterator old = *this;
+            ++*this;
+            return old;
+        }
+        bool operator==(const iterator& other) const {
+            return node_ == other.node_;
+        }
+        bool operator!=(const iterator& other) const {
+            return node_ != other.node_;
+        }
+
+     private:
+        friend class IntrusiveList;
+        explicit iterator(T* node): node_{node} {}
+        T* node_{nullptr};
+    };
+
+ private:
+    static ListHook<T>& hook(const T* node) {
+        return const_cast<T*>(node)->*Hook;
+    }
+
+    //! marca data como ligada; out_of_range se ja estava
+    static void claim(T& data);
+
+    //! objeto na posicao index, andando a partir da ponta mais perto
+    T* node_at(std::size_t index) const;
+
+    T* head{nullptr};
+    T* tail{nullptr};
+    std::size_t size_{0u};
+};
+
+}  // namespace structures
+
+template<typename T, structures::ListHook<T> T::*Hook>
+structures::IntrusiveList<T, Hook>::IntrusiveList() {}
+
+template<typename T, structures::ListHook<T> T::*Hook>
+structures::IntrusiveList<T, Hook>::~IntrusiveList() {
+    clear();
+}
+
+template<typename T, structures::ListHook<T> T::*Hook>
+void structures::IntrusiveList<T, Hook>::clear() {
+    while (head != nullptr) {
+        T* next = hook(head).next_;
+        hook(head).prev_ = nullptr;
+        hook(head).next_ = nullptr;
+        hook(head).linked_ = false;
+        head = next;
+    }
+    tail = nullptr;
+    size_ = 0u;
+}
+
+template<typename T, structures::ListHook<T> T::*Hook>
+void structures::IntrusiveList<T, Hook>::claim(T& data) {
+    if (hook(&data).linked_) {
+        throw std::out_of_range("object is already linked");
+    }
+    hook(&data).linked_ = true;
+}
+
+template<typename T, structures::ListHook<T> T::*Hook>
+T* structures::IntrusiveList<T, Hook>::node_at(std::size_t index) const {
+    T* it;
+    if (index < size_ - index) {
+        it = head;
+        for (std::size_t i = 0u; i < index; i++) {
+            it = hook(it).next_;
+        }
+    } else {
+        it = tail;
+        for (std::size_t i = size_ - 1u; i > index; i--) {
+            it = hook(it).prev_;
+        }
+    }
+    return it;
+}
+
+template<typename T, structures::ListHook<T> T::*Hook>
+void structures::IntrusiveList<T, Hook>::push_back(T& data) {
+    claim(data);
+    hook(&data).prev_ = tail;
+    hook(&data).next_ = nullptr;
+    if (tail == nullptr) {
+        head = &data;
+    } else {
+        hook(tail).next_ = &data;
+    }
+    tail = &data;
+    size_++;
+}
+
+template<typename T, structures::ListHook<T> T::*Hook>
+void structures::IntrusiveList<T, Hook>::push_front(T& data) {
+    claim(data);
+    hook(&data).prev_ = nullptr;
+    hook(&data).next_ = head;
+    if (head == nullptr) {
+        tail = &data;
+    } else {
+        hook(head).prev_ = &data;
+    }
+    head = &data;
+    size_++;
+}
+
+template<typename T, structures::ListHook<T> T::*Hook>
+void structures::IntrusiveList<T, Hook>::insert(T& data, std::size_t index) {
+    if (index > size_) {
+        throw std::out_of_range("invalid index");
+    } else if (index == 0u) {
+        push_front(data);
+    } else if (index == size_) {
+        push_back(data);
+    } else {
+        claim(data);
+        T* current = node_at(index);
+        T* previous = hook(current).prev_;
+        hook(&data).prev_ = previous;
+        hook(&data).next_ = current;
+        hook(previous).next_ = &data;
+        hook(current).prev_ = &data;
+        size_++;
+    }
+}
+
+template<typename T, structures::ListHook<T> T::*Hook>
+void structures::IntrusiveList<T, Hook>::insert_sorted(T& data) {
+    T* current = head;
+    while (current != nullptr && *current < data) {
+        current = hook(current).next_;
+    }
+    if (current == nullptr) {
+        push_back(data);
+    } else if (current == head) {
+        push_front(data);
+    } else {
+        claim(data);
+        T* previous = hook(current).prev_;
+        hook(&data).prev_ = previous;
+        hook(&data).next_ = current;
+        hook(previous).next_ = &data;
+        hook(current).prev_ = &data;
+        size_++;
+    }
+}
+
+template<typename T, structures::ListHook<T> T::*Hook>
+T& structures::IntrusiveList<T, Hook>::pop(std::size_t index) {
+    if (size_ == 0u) {
+        throw std::out_of_range("the list is empty");
+    }
+    if (index >= size_) {
+        throw std::out_of_range("invalid index");
+    }
+    T* popped = node_at(index);
+    remove(*popped);
+    return *popped;
+}
+
+template<typename T, structures::ListHook<T> T::*Hook>
+T& structures::IntrusiveList<T, Hook>::pop_back() {
+    if (size_ == 0u) {
+        throw std::out_of_range("the list is empty");
+    }
+    T* popped = tail;
+    remove(*popped);
+    return *popped;
+}
+
+template<typename T, structures::ListHook<T> T::*Hook>
+T& structures::IntrusiveList<T, Hook>::pop_front() {
+    if (size_ == 0u) {
+        throw std::out_of_range("the list is empty");
+    }
+    T* popped = head;
+    remove(*popped);
+    return *popped;
+}
+
+template<typename T, structures::ListHook<T> T::*Hook>
+void structures::IntrusiveList<T, Hook>::remove(T& data) {
+    // o gancho ja sabe os vizinhos: nada de find antes de desligar
+    ListHook<T>& links = hook(&data);
+    if (!links.linked_ || (links.prev_ == nullptr && head != &data)) {
+        throw std::out_of_range("object is not in the list");
+    }
+    if (links.prev_ == nullptr) {
+        head = links.next_;
+    } else {
+        hook(links.prev_).next_ = links.next_;
+    }
+    if (links.next_ == nullptr) {
+        tail = links.prev_;
+    } else {
+        hook(links.next_).prev_ = links.prev_;
+    }
+    links.prev_ = nullptr;
+    links.next_ = nullptr;
+    links.linked_ = false;
+    size_--;
+}
+
+template<typename T, structures::ListHook<T> T::*Hook>
+void structures::IntrusiveList<T, Hook>::splice(IntrusiveList& other) {
+    if (&other == this || other.empty()) {
+        return;
+    }
+    if (empty()) {
+        head = other.head;
+    } else {
+        hook(tail).next_ = other.head;
+        hook(other.head).prev_ = tail;
+    }
+    tail = other.tail;
+    size_ += other.size_;
+    other.head = nullptr;
+    other.tail = nullptr;
+    other.size_ = 0u;
+}
+
+template<typename T, structures::ListHook<T> T::*Hook>
+void structures::IntrusiveList<T, Hook>::swap(IntrusiveList& other) {
+    // as pontas nao apontam para a lista, entao basta trocar os campos
+    T* other_head = other.head;
+    T* other_tail = other.tail;
+    std::size_t other_size = other.size_;
+    other.head = head;
+    other.tail = tail;
+    other.size_ = size_;
+    head = other_head;
+    tail = other_tail;
+    size_ = other_size;
+}
+
+template<typename T, structures::ListHook<T> T::*Hook>
+bool structures::IntrusiveList<T, Hook>::empty() const {
+    return size_ == 0u;
+}
+
+template<typename T, structures::ListHook<T> T::*Hook>
+bool structures::IntrusiveList<T, Hook>::contains(const T& data) const {
+    return find(data) != size_;
+}
+
+template<typename T, structures::ListHook<T> T::*Hook>
+T& structures::IntrusiveList<T, Hook>::at(std::size_t index) {
+    if (index >= size_) {
+        throw std::out_of_range("invalid index");
+    }
+    return *node_at(index);
+}
+
+template<typename T, structures::ListHook<T> T::*Hook>
+const T& structures::IntrusiveList<T, Hook>::at(std::size_t index) const {
+    if (index >= size_) {
+        throw std::out_of_range("invalid index");
+    }
+    return *node_at(index);
+}
+
+template<typename T, structures::ListHook<T> T::*Hook>
+T& structures::IntrusiveList<T, Hook>::front() {
+    if (size_ == 0u) {
+        throw std::out_of_range("the list is empty");
+    }
+    return *head;
+}
+
+template<typename T, structures::ListHook<T> T::*Hook>
+T& structures::IntrusiveList<T, Hook>::back() {
+    if (size_ == 0u) {
+        throw std::out_of_range("the list is empty");
+    }
+    return *tail;
+}
+
+template<typename T, structures::ListHook<T> T::*Hook>
+std::size_t structures::IntrusiveList<T, Hook>::find(const T& data) const {
+    // compara identidade: o mesmo objeto, nao um valor igual
+    std::size_t index = 0u;
+    for (const T* it = head; it != nullptr; it = hook(it).next_) {
+        if (it == &data) {
+            return index;
+        }
+        index++;
+    }
+    return size_;
+}
+
+template<typename T, structures::ListHook<T> T::*Hook>
+std::size_t structures::IntrusiveList<T, Hook>::size() const {
+    return size_;
+}
+
+template<typename T, structures::ListHook<T> T::*Hook>
+typename structures::IntrusiveList<T, Hook>::iterator
+structures::IntrusiveList<T, Hook>::begin() {
+    return iterator(head);
+}
+
+template<typename T, structures::ListHook<T> T::*Hook>
+typename structures::IntrusiveList<T, Hook>::iterator
+structures::IntrusiveList<T, Hook>::end() {
+    return iterator(nullptr);
+}
+
+#endif
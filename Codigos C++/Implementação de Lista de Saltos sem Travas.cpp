@@ -0,0 +1,506 @@
+#ifndef STRUCTURES_LOCK_FREE_SKIP_LIST_H
+#define STRUCTURES_LOCK_FREE_SKIP_LIST_H
+
+#include <atomic>  // std::atomic
+#include <cstdint>  // std::size_t, std::uint64_t, std::uintptr_t
+#include <functional>  // std::less
+#include <new>  // ::operator new, std::align_val_t
+
+namespace structures {
+
+namespace detail {
+
+//! objeto que pode ser entregue a reclamacao por epocas
+struct Reclaimable {
+    Reclaimable* next_retired{nullptr};
+    void (*reclaim)(Reclaimable*){nullptr};
+};
+
+//! reclamacao por epocas, uma para o processo todo: quem le estruturas
+//! compartilhadas fica dentro de um Guard; um objeto retirado na epoca g
+//! so e liberado quando a epoca global chega a g + 2, pois entao nenhuma
+//! thread que podia enxerga-lo continua dentro de um Guard
+class Epochs {
+ public:
+    //! marca a thread como ativa ate o fim do escopo (pode aninhar)
+    class Guard {
+     public:
+        Guard();
+        ~Guard();
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+    };
+
+    //! entrega um objeto ja desligado da estrutura; a thread deve estar
+    //! dentro de um Guard
+    static void retire(Reclaimable* object);
+
+ private:
+    //! estado de uma thread; nunca liberado, reaproveitado por outra
+    //! thread quando a dona termina
+    struct Record {
+        std::atomic<std::uint64_t> epoch{0u};  // (epoca << 1) | ativo
+        std::atomic<bool> in_use{true};
+        Record* next{nullptr};
+        std::size_t depth{0u};
+        std::size_t retired{0u};
+        Reclaimable* limbo[3] = {};
+        std::uint64_t limbo_epoch[3] = {};
+    };
+
+    //! devolve o Record quando a thread termina
+    struct Holder {
+        Record* record{nullptr};
+        ~Holder();
+    };
+
+    static const std::size_t ADVANCE_EVERY = 32u;
+
+    static std::atomic<std::uint64_t>& global();
+    static std::atomic<Record*>& records();
+    static Record& local();
+    //! libera a lista de objetos
+    static void reclaim(Reclaimable* list);
+    //! avanca a epoca global se todas as threads ativas ja a viram
+    static void try_advance(std::uint64_t epoch);
+};
+
+}  // namespace detail
+
+template<typename T, typename Compare = std::less<T>>
+//! conjunto ordenado sem travas: lista de Harris-Michael no nivel de
+//! baixo com indice de lista de saltos por cima (Herlihy-Shavit); nodos
+//! removidos sao liberados por reclamacao por epocas
+class LockFreeSkipList {
+ public:
+    //! construtor padrao
+    explicit LockFreeSkipList(const Compare& comp = Compare());
+    //! destrutor (sem operacoes concorrentes)
+    ~LockFreeSkipList();
+    LockFreeSkipList(const LockFreeSkipList&) = delete;
+    LockFreeSkipList& operator=(const LockFreeSkipList&) = delete;
+    //! insere data; false se ja existia
+    bool insert(const T& data);
+    //! remove data; false se nao existia
+    bool remove(const T& data);
+    //! verifica se contem data (sem escrever na lista)
+    bool contains(const T& data) const;
+    //! percorre em ordem; fracamente consistente: ve cada elemento que
+    //! ficou presente durante todo o percurso, e talvez os demais
+    template<typename Function>
+    void for_each(Function function) const;
+    //! tamanho aproximado
+    std::size_t size() const;
+    //! verifica se vazia (aproximado)
+    bool empty() const;
+
+ private:
+    using Link = std::atomic<std::uintptr_t>;  // ponteiro | marca (bit 0)
+
+    struct Node : detail::Reclaimable {
+        Node(const T& data_, std::size_t height_):
+            data{data_},
+            height{height_}
+        {}
+
+        //! torre de height ligacoes, logo apos o nodo
+        Link* next() {
+            return reinterpret_cast<Link*>(this + 1);
+        }
+
+        T data;
+        std::size_t height;
+        std::atomic<unsigned> state{0u};  // INSERTED | REMOVED
+    };
+
+    static const std::size_t MAX_LEVEL = 16u;
+    static const unsigned INSERTED = 1u;  // insercao parou de ligar niveis
+    static const unsigned REMOVED = 2u;  // remocao marcou todos os niveis
+
+    static Node* pointer(std::uintptr_t link);
+    static bool marked(std::uintptr_t link);
+    static std::uintptr_t link(Node* node);
+    static std::size_t random_height();
+    static Node* create(std::size_t height, const T& data);
+    static void destroy(detail::Reclaimable* object);
+    //! predecessores e sucessores de data em cada nivel, desligando os
+    //! nodos marcados pelo caminho; true se achou data
+    bool search(const T& data, Link** preds, Node** succs) const;
+    //! chamado por quem chegar por ultimo (insercao ou remocao):
+    //! garante que o nodo saiu de todos os niveis e o retira
+    void finish(Node* node);
+    bool less(const T& a, const T& b) const;
+
+    Compare comp_;
+    mutable Link head_[MAX_LEVEL];
+    std::atomic<std::size_t> size_{0u};
+};
+
+}  // namespace structures
+
+inline std::atomic<std::uint64_t>& structures::detail::Epochs::global() {
+    static std::atomic<std::uint64_t> epoch{1u};
+    return epoch;
+}
+
+inline std::atomic<structures::detail::Epochs::Record*>&
+structures::detail::Epochs::records() {
+    static std::atomic<Record*> head{nullptr};
+    return head;
+}
+
+inline structures::detail::Epochs::Holder::~Holder() {
+    if (record != nullptr) {
+        record->epoch.store(0u);
+        record->in_use.store(false, std::memory_order_release);
+    }
+}
+
+inline structures::detail::Epochs::Record&
+structures::detail::Epochs::local() {
+    thread_local Holder holder;
+    if (holder.record == nullptr) {
+        // reaproveita o Record de uma thread encerrada, com o que ela
+        // deixou para liberar
+        for (Record* it = records().load(); it != nullptr; it = it->next) {
+            bool expected = false;
+            if (it->in_use.compare_exchange_strong(expected, true)) {
+                holder.record = it;
+                return *it;
+            }
+        }
+        Record* record = new Record;
+        Record* head = records().load();
+        do {
+            record->next = head;
+        } while (!records().compare_exchange_weak(head, record));
+        holder.record = record;
+    }
+    return *holder.record;
+}
+
+inline structures::detail::Epochs::Guard::Guard() {
+    Record& record = local();
+    if (record.depth++ == 0u) {
+        record.epoch.store((global().load() << 1) | 1u);
+    }
+}
+
+inline structures::detail::Epochs::Guard::~Guard() {
+    Record& record = local();
+    if (--record.depth == 0u) {
+        record.epoch.store(0u, std::memory_order_release);
+    }
+}
+
+inline void structures::detail::Epochs::reclaim(Reclaimable* list) {
+    while (list != nullptr) {
+        Reclaimable* next = list->next_retired;
+        list->reclaim(list);
+        list = next;
+    }
+}
+
+inline void structures::detail::Epochs::try_advance(std::uint64_t epoch) {
+    for (Record* it = records().load(); it != nullptr; it = it->next) {
+        std::uint64_t seen = it->epoch.load();
+        if ((seen & 1u) != 0u && (seen >> 1) != epoch) {
+            return;
+        }
+    }
+    global().compare_exchange_strong(epoch, epoch + 1u);
+}
+
+inline void structures::detail::Epochs::retire(Reclaimable* object) {
+    Record& record = local();
+    // epoca global de agora, nao a anunciada: o objeto ja foi desligado
+    std::uint64_t epoch = global().load();
+    for (std::size_t i = 0u; i < 3u; i++) {
+        if (record.limbo[i] != nullptr && record.limbo_epoch[i] + 2u <= epoch) {
+            Reclaimable* list = record.limbo[i];
+            record.limbo[i] = nullptr;
+            reclaim(list);
+        }
+    }
+    std::size_t slot = epoch % 3u;
+    if (record.limbo[slot] != nullptr && record.limbo_epoch[slot] != epoch) {
+        Reclaimable* list = record.limbo[slot];
+        record.limbo[slot] = nullptr;
+        reclaim(list);
+    }
+    record.limbo_epoch[slot] = epoch;
+    object->next_retired = record.limbo[slot];
+    record.limbo[slot] = object;
+    if (++record.retired % ADVANCE_EVERY == 0u) {
+        try_advance(epoch);
+    }
+}
+
+template<typename T, typename Compare>
+structures::LockFreeSkipList<T, Compare>::LockFreeSkipList(
+    const Compare& comp):
+    comp_{comp} {
+    for (std::size_t l = 0u; l < MAX_LEVEL; l++) {
+        head_[l].store(0u, std::memory_order_relaxed);
+    }
+}
+
+template<typename T, typename Compare>
+structures::LockFreeSkipList<T, Compare>::~LockFreeSkipList() {
+    Node* node = pointer(head_[0].load(std::memory_order_relaxed));
+    while (node != nullptr) {
+        Node* next = pointer(node->next()[0].load(std::memory_order_relaxed));
+        destroy(node);
+        node = next;
+    }
+}
+
+template<typename T, typename Compare>
+typename structures::LockFreeSkipList<T, Compare>::Node*
+structures::LockFreeSkipList<T, Compare>::pointer(std::uintptr_t link) {
+    return reinterpret_cast<Node*>(link & ~std::uintptr_t{1u});
+}
+
+template<typename T, typename Compare>
+bool structures::LockFreeSkipList<T, Compare>::marked(std::uintptr_t link) {
+    return (link & 1u) != 0u;
+}
+
+template<typename T, typename Compare>
+std::uintptr_t structures::LockFreeSkipList<T, Compare>::link(Node* node) {
+    return reinterpret_cast<std::uintptr_t>(node);
+}
+
+template<typename T, typename Compare>
+bool structures::LockFreeSkipList<T, Compare>::less(const T& a,
+                                                    const T& b) const {
+    return comp_(a, b);
+}
+
+template<typename T, typename Compare>
+std::size_t structures::LockFreeSkipList<T, Compare>::random_height() {
+    thread_local std::uint64_t seed =
+        reinterpret_cast<std::uintptr_t>(&seed) | 1u;
+    seed ^= seed << 13;
+    seed ^= seed >> 7;
+    seed ^= seed << 17;
+    std::uint64_t bits = seed;
+    std::size_t height = 1u;
+    while (height < MAX_LEVEL && (bits & 3u) == 0u) {
+        height++;
+        bits >>= 2;
+    }
+    return height;
+}
+
+template<typename T, typename Compare>
+typename structures::LockFreeSkipList<T, Compare>::Node*
+structures::LockFreeSkipList<T, Compare>::create(std::size_t height,
+                                                 const T& data) {
+    void* raw = ::operator new(sizeof(Node) + height * sizeof(Link),
+                               std::align_val_t{alignof(Node)});
+    Node* node;
+    try {
+        node = new (raw) Node(data, height);
+    } catch (...) {
+        ::operator delete(raw, std::align_val_t{alignof(Node)});
+        throw;
+    }
+    for (std::size_t l = 0u; l < height; l++) {
+        new (node->next() + l) Link(0u);
+    }
+    node->reclaim = &destroy;
+    return node;
+}
+
+template<typename T, typename Compare>
+void structures::LockFreeSkipList<T, Compare>::destroy(
+    detail::Reclaimable* object) {
+    // nao depende da lista: pode rodar depois que ela ja foi destruida
+    Node* node = static_cast<Node*>(object);
+    node->~Node();
+    ::operator delete(static_cast<void*>(node),
+                      std::align_val_t{alignof(Node)});
+}
+
+template<typename T, typename Compare>
+bool structures::LockFreeSkipList<T, Compare>::search(
+    const T& data, Link** preds, Node** succs) const {
+retry:
+    Link* pred = head_;
+    Node* curr = nullptr;
+    for (std::size_t l = MAX_LEVEL; l-- > 0u;) {
+        curr = pointer(pred[l].load());
+        while (curr != nullptr) {
+            std::uintptr_t succ = curr->next()[l].load();
+            while (marked(succ)) {
+                // curr foi removido: desliga neste nivel
+                std::uintptr_t expected = link(curr);
+                if (!pred[l].compare_exchange_strong(expected,
+                                                     link(pointer(succ)))) {
+                    goto retry;
+                }
+                curr = pointer(succ);
+                if (curr == nullptr) {
+                    break;
+                }
+                succ = curr->next()[l].load();
+            }
+            if (curr == nullptr || !less(curr->data, data)) {
+                break;
+            }
+            pred = curr->next();
+            curr = pointer(succ);
+        }
+        preds[l] = pred + l;
+        succs[l] = curr;
+    }
+    return curr != nullptr && !less(data, curr->data);
+}
+
+template<typename T, typename Compare>
+void structures::LockFreeSkipList<T, Compare>::finish(Node* node) {
+    // o nodo e o primeiro com a sua chave em todo nivel em que aparece,
+    // entao uma busca por ela passa por ele e o desliga
+    Link* preds[MAX_LEVEL];
+    Node* succs[MAX_LEVEL];
+    search(node->data, preds, succs);
+    detail::Epochs::retire(node);
+}
+
+template<typename T, typename Compare>
+bool structures::LockFreeSkipList<T, Compare>::insert(const T& data) {
+    detail::Epochs::Guard guard;
+    Link* preds[MAX_LEVEL];
+    Node* succs[MAX_LEVEL];
+    Node* node = nullptr;
+    for (;;) {
+        if (search(data, preds, succs)) {
+            if (node != nullptr) {
+                destroy(node);  // nunca foi publicado
+            }
+            return false;
+        }
+        if (node == nullptr) {
+            node = create(random_height(), data);
+        }
+        for (std::size_t l = 0u; l < node->height; l++) {
+            node->next()[l].store(link(succs[l]), std::memory_order_relaxed);
+        }
+        // ponto de linearizacao: ligar no nivel de baixo
+        std::uintptr_t expected = link(succs[0]);
+        if (preds[0]->compare_exchange_strong(expected, link(node))) {
+            break;
+        }
+    }
+    size_.fetch_add(1u, std::memory_order_relaxed);
+    for (std::size_t l = 1u; l < node->height; l++) {
+        bool linked = false;
+        while (!linked) {
+            std::uintptr_t current = node->next()[l].load();
+            if (marked(current)) {
+                goto done;  // ja esta sendo removido: para de subir
+            }
+            if (pointer(current) != succs[l] &&
+                !node->next()[l].compare_exchange_strong(current,
+                                                         link(succs[l]))) {
+                goto done;
+            }
+            std::uintptr_t expected = link(succs[l]);
+            linked = preds[l]->compare_exchange_strong(expected, link(node));
+            if (!linked) {
+                search(data, preds, succs);
+                if (succs[0] != node) {
+                    goto done;
+                }
+            }
+        }
+    }
+done:
+    if ((node->state.fetch_or(INSERTED) & REMOVED) != 0u) {
+        finish(node);
+    }
+    return true;
+}
+
+template<typename T, typename Compare>
+bool structures::LockFreeSkipList<T, Compare>::remove(const T& data) {
+    detail::Epochs::Guard guard;
+    Link* preds[MAX_LEVEL];
+    Node* succs[MAX_LEVEL];
+    if (!search(data, preds, succs)) {
+        return false;
+    }
+    Node* node = succs[0];
+    for (std::size_t l = node->height; l-- > 1u;) {
+        std::uintptr_t current = node->next()[l].load();
+        while (!marked(current) &&
+               !node->next()[l].compare_exchange_weak(current, current | 1u)) {
+        }
+    }
+    // ponto de linearizacao: marcar o nivel de baixo
+    std::uintptr_t current = node->next()[0].load();
+    for (;;) {
+        if (marked(current)) {
+            return false;  // outra remocao chegou antes
+        }
+        if (node->next()[0].compare_exchange_weak(current, current | 1u)) {
+            break;
+        }
+    }
+    size_.fetch_sub(1u, std::memory_order_relaxed);
+    if ((node->state.fetch_or(REMOVED) & INSERTED) != 0u) {
+        finish(node);
+    }
+    return true;
+}
+
+template<typename T, typename Compare>
+bool structures::LockFreeSkipList<T, Compare>::contains(const T& data) const {
+    detail::Epochs::Guard guard;
+    Link* pred = head_;
+    Node* curr = nullptr;
+    for (std::size_t l = MAX_LEVEL; l-- > 0u;) {
+        curr = pointer(pred[l].load());
+        while (curr != nullptr) {
+            std::uintptr_t succ = curr->next()[l].load();
+            if (marked(succ)) {
+                curr = pointer(succ);  // pula sem desligar
+            } else if (less(curr->data, data)) {
+                pred = curr->next();
+                curr = pointer(succ);
+            } else {
+                break;
+            }
+        }
+    }
+    return curr != nullptr && !less(data, curr->data) &&
+           !marked(curr->next()[0].load());
+}
+
+template<typename T, typename Compare>
+template<typename Function>
+void structures::LockFreeSkipList<T, Compare>::for_each(
+    Function function) const {
+    detail::Epochs::Guard guard;
+    Node* node = pointer(head_[0].load());
+    while (node != nullptr) {
+        std::uintptr_t next = node->next()[0].load();
+        if (!marked(next)) {
+            function(static_cast<const T&>(node->data));
+        }
+        node = pointer(next);
+    }
+}
+
+template<typename T, typename Compare>
+std::size_t structures::LockFreeSkipList<T, Compare>::size() const {
+    return size_.load(std::memory_order_relaxed);
+}
+
+template<typename T, typename Compare>
+bool structures::LockFreeSkipList<T, Compare>::empty() const {
+    return size() == 0u;
+}
+
+#endif
@@ -0,0 +1,480 @@
+#ifndef STRUCTURES_SKIP_LIST_H
+#define STRUCTURES_SKIP_LIST_H
+
+#include <cstddef>  // std::ptrdiff_t
+#include <cstdint>  // std::size_t, std::uint64_t, std::uintptr_t
+#include <functional>  // std::less
+#include <iterator>  // std::forward_iterator_tag
+#include <memory>  // std::allocator, std::allocator_traits
+#include <memory_resource>  // std::pmr::polymorphic_allocator
+#include <stdexcept>  // C++ exceptions
+#include <type_traits>  // std::aligned_storage
+#include <utility>  // std::move
+
+namespace structures {
+
+template<typename T, typename Compare = std::less<T>,
+         typename Allocator = std::allocator<T>>
+//! lista de saltos ordenada e indexavel: mesmas operacoes da lista
+//! ordenada (insert_sorted, find, remove, at, pop) em O(log n) esperado.
+//! Cada nodo guarda a torre de ligacoes logo depois do dado, numa unica
+//! alocacao tirada de uma arena em blocos; nodos liberados voltam a uma
+//! lista livre por altura.
+class SkipList {
+    struct Node;
+
+ public:
+    class const_iterator;
+
+    //! construtor padrao
+    explicit SkipList(const Compare& comp = Compare(),
+                      const Allocator& alloc = Allocator());
+    //! destrutor
+    ~SkipList();
+    SkipList(const SkipList&) = delete;
+    SkipList& operator=(const SkipList&) = delete;
+    //! limpa (os nodos ficam nas listas livres)
+    void clear();
+    //! insere mantendo a ordem (depois dos iguais)
+    void insert_sorted(const T& data);
+    //! retira da posicao index
+    T pop(std::size_t index);
+    //! retira o menor
+    T pop_front();
+    //! retira o maior
+    T pop_back();
+    //! remove a primeira ocorrencia de data
+    void remove(const T& data);
+    //! verifica se vazia
+    bool empty() const;
+    //! verifica se contem data
+    bool contains(const T& data) const;
+    //! elemento na posicao index
+    const T& at(std::size_t index) const;
+    //! posicao da primeira ocorrencia de data, ou size() se nao houver
+    std::size_t find(const T& data) const;
+    //! tamanho atual
+    std::size_t size() const;
+    //! percurso em ordem
+    const_iterator begin() const;
+    const_iterator end() const;
+    //! retorna o alocador
+    Allocator get_allocator() const;
+
+    //! iterador de avanco, em ordem crescente
+    class const_iterator {
+     public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        const_iterator() = default;
+        reference operator*() const { return node_->data; }
+        pointer operator->() const { return &node_->data; }
+        const_iterator& operator++() {
+            node_ = node_->links()[0].next;
+            return *this;
+        }
+        const_iterator operator++(int) {
+            const_iterator old = *this;
+            ++*this;
+            return old;
+        }
+        bool operator==(const const_iterator& other) const {
+            return node_ == other.node_;
+        }
+        bool operator!=(const const_iterator& other) const {
+            return node_ != other.node_;
+        }
+
+     private:
+        friend class SkipList;
+        explicit const_iterator(Node* node): node_{node} {}
+        Node* node_{nullptr};
+    };
+
+ private:
+    //! ligacao de um nivel; width = quantos elementos ela pula
+    struct Link {
+        Node* next;
+        std::size_t width;
+    };
+
+    struct Node {
+        T data;
+        std::size_t height;
+
+        //! torre de height ligacoes, logo apos o nodo
+        Link* links() {
+            return reinterpret_cast<Link*>(this + 1);
+        }
+    };
+
+    //! unidade de alocacao da arena, com o alinhamento do nodo
+    using Unit = typename std::aligned_storage<alignof(Node),
+                                               alignof(Node)>::type;
+
+    //! cabecalho de cada bloco da arena
+    struct Block {
+        Block* next;
+        std::size_t units;
+    };
+
+    using Traits = std::allocator_traits<Allocator>;
+    using UnitAllocator = typename Traits::template rebind_alloc<Unit>;
+    using UnitTraits = std::allocator_traits<UnitAllocator>;
+
+    static const std::size_t MAX_LEVEL = 16u;  // p = 1/4: ate 4^16 nodos
+    static const std::size_t BLOCK_BYTES = 16384u;
+
+    //! unidades para n bytes
+    static std::size_t units_for(std::size_t bytes);
+    //! bytes de um nodo com torre de altura height
+    static std::size_t node_units(std::size_t height);
+    //! altura aleatoria (geometrica com p = 1/4)
+    std::size_t random_height();
+    //! reserva memoria para um nodo (lista livre ou arena)
+    Node* acquire(std::size_t height);
+    //! devolve a memoria do nodo a lista livre da sua altura
+    void release(Node* node);
+    //! cria um nodo com data
+    Node* allocate_node(std::size_t height, const T& data);
+    //! destroi o dado e devolve o nodo
+    void deallocate_node(Node* node);
+    //! predecessores de data em cada nivel (e suas posicoes);
+    //! upper escolhe o ultimo < ou o ultimo <= data
+    void search(const T& data, bool upper, Link** update,
+                std::size_t* rank) const;
+    //! predecessores da posicao index em cada nivel
+    void search_index(std::size_t index, Link** update) const;
+    //! desliga o nodo seguinte a update[0]
+    T unlink(Link** update);
+
+    Compare comp_;
+    Allocator alloc_;
+    UnitAllocator unit_alloc_;
+    mutable Link head_[MAX_LEVEL];
+    std::size_t size_{0u};
+    std::uint64_t seed_;
+    Block* blocks_{nullptr};
+    Unit* cursor_{nullptr};  // proxima unidade livre do bloco atual
+    std::size_t remaining_{0u};  // unidades livres no bloco atual
+    void* free_[MAX_LEVEL] = {};  // listas livres por altura
+};
+
+namespace pmr {
+
+//! SkipList alocando de um std::pmr::memory_resource
+template<typename T, typename Compare = std::less<T>>
+using SkipList =
+    structures::SkipList<T, Compare, std::pmr::polymorphic_allocator<T>>;
+
+}  // namespace pmr
+
+}  // namespace structures
+
+template<typename T, typename Compare, typename Allocator>
+structures::SkipList<T, Compare, Allocator>::SkipList(const Compare& comp,
+                                                      const Allocator& alloc):
+    comp_{comp},
+    alloc_{alloc},
+    unit_alloc_{alloc},
+    seed_{reinterpret_cast<std::uintptr_t>(this) | 1u} {
+    for (std::size_t l = 0u; l < MAX_LEVEL; l++) {
+        head_[l] = Link{nullptr, 1u};
+    }
+}
+
+template<typename T, typename Compare, typename Allocator>
+structures::SkipList<T, Compare, Allocator>::~SkipList() {
+    clear();
+    while (blocks_ != nullptr) {
+        Block* next = blocks_->next;
+        UnitTraits::deallocate(unit_alloc_, reinterpret_cast<Unit*>(blocks_),
+                               blocks_->units);
+        blocks_ = next;
+    }
+}
+
+template<typename T, typename Compare, typename Allocator>
+std::size_t structures::SkipList<T, Compare, Allocator>::units_for(
+    std::size_t bytes) {
+    return (bytes + sizeof(Unit) - 1u) / sizeof(Unit);
+}
+
+template<typename T, typename Compare, typename Allocator>
+std::size_t structures::SkipList<T, Compare, Allocator>::node_units(
+    std::size_t height) {
+    return units_for(sizeof(Node) + height * sizeof(Link));
+}
+
+template<typename T, typename Compare, typename Allocator>
+std::size_t structures::SkipList<T, Compare, Allocator>::random_height() {
+    seed_ ^= seed_ << 13;
+    seed_ ^= seed_ >> 7;
+    seed_ ^= seed_ << 17;
+    std::uint64_t bits = seed_;
+    std::size_t height = 1u;
+    while (height < MAX_LEVEL && (bits & 3u) == 0u) {
+        height++;
+        bits >>= 2;
+    }
+    return height;
+}
+
+template<typename T, typename Compare, typename Allocator>
+typename structures::SkipList<T, Compare, Allocator>::Node*
+structures::SkipList<T, Compare, Allocator>::acquire(std::size_t height) {
+    void*& free = free_[height - 1u];
+    if (free != nullptr) {
+        void* p = free;
+        free = *static_cast<void**>(p);
+        return static_cast<Node*>(p);
+    }
+    std::size_t units = node_units(height);
+    if (remaining_ < units) {
+        // bloco novo; o resto do bloco atual fica sem uso
+        std::size_t header = units_for(sizeof(Block));
+        std::size_t total = units_for(BLOCK_BYTES);
+        if (total < header + node_units(MAX_LEVEL)) {
+            total = header + node_units(MAX_LEVEL);
+        }
+        Unit* raw = UnitTraits::allocate(unit_alloc_, total);
+        Block* block = reinterpret_cast<Block*>(raw);
+        block->next = blocks_;
+        block->units = total;
+        blocks_ = block;
+        cursor_ = raw + header;
+        remaining_ = total - header;
+    }
+    Node* node = reinterpret_cast<Node*>(cursor_);
+    cursor_ += units;
+    remaining_ -= units;
+    return node;
+}
+
+template<typename T, typename Compare, typename Allocator>
+void structures::SkipList<T, Compare, Allocator>::release(Node* node) {
+    void*& free = free_[node->height - 1u];
+    void* p = node;
+    *static_cast<void**>(p) = free;
+    free = p;
+}
+
+template<typename T, typename Compare, typename Allocator>
+typename structures::SkipList<T, Compare, Allocator>::Node*
+structures::SkipList<T, Compare, Allocator>::allocate_node(
+    std::size_t height, const T& data) {
+    Node* node = acquire(height);
+    try {
+        Traits::construct(alloc_, &node->data, data);
+    } catch (...) {
+        node->height = height;
+        release(node);
+        throw;
+    }
+    node->height = height;
+    return node;
+}
+
+template<typename T, typename Compare, typename Allocator>
+void structures::SkipList<T, Compare, Allocator>::deallocate_node(
+    Node* node) {
+    Traits::destroy(alloc_, &node->data);
+    release(node);
+}
+
+template<typename T, typename Compare, typename Allocator>
+void structures::SkipList<T, Compare, Allocator>::clear() {
+    Node* node = head_[0].next;
+    while (node != nullptr) {
+        Node* next = node->links()[0].next;
+        deallocate_node(node);
+        node = next;
+    }
+    for (std::size_t l = 0u; l < MAX_LEVEL; l++) {
+        head_[l] = Link{nullptr, 1u};
+    }
+    size_ = 0u;
+}
+
+template<typename T, typename Compare, typename Allocator>
+void structures::SkipList<T, Compare, Allocator>::search(
+    const T& data, bool upper, Link** update, std::size_t* rank) const {
+    // posicao 0 e a cabeca; o primeiro elemento tem posicao 1
+    Link* links = head_;
+    std::size_t position = 0u;
+    for (std::size_t l = MAX_LEVEL; l-- > 0u;) {
+        for (Node* next = links[l].next; next != nullptr;
+             next = links[l].next) {
+            bool before = upper ? !comp_(data, next->data)
+                                : comp_(next->data, data);
+            if (!before) {
+                break;
+            }
+            position += links[l].width;
+            links = next->links();
+        }
+        update[l] = links + l;
+        if (rank != nullptr) {
+            rank[l] = position;
+        }
+    }
+}
+
+template<typename T, typename Compare, typename Allocator>
+void structures::SkipList<T, Compare, Allocator>::search_index(
+    std::size_t index, Link** update) const {
+    // para logo antes da posicao index + 1
+    Link* links = head_;
+    std::size_t position = 0u;
+    for (std::size_t l = MAX_LEVEL; l-- > 0u;) {
+        while (links[l].next != nullptr &&
+               position + links[l].width <= index) {
+            position += links[l].width;
+            links = links[l].next->links();
+        }
+        update[l] = links + l;
+    }
+}
+
+template<typename T, typename Compare, typename Allocator>
+void structures::SkipList<T, Compare, Allocator>::insert_sorted(
+    const T& data) {
+    Link* update[MAX_LEVEL];
+    std::size_t rank[MAX_LEVEL];
+    search(data, true, update, rank);
+    std::size_t height = random_height();
+    Node* node = allocate_node(height, data);
+    Link* links = node->links();
+    std::size_t position = rank[0] + 1u;
+    for (std::size_t l = 0u; l < MAX_LEVEL; l++) {
+        if (l < height) {
+            // divide a ligacao de update[l] em duas, passando pelo nodo
+            std::size_t width = update[l]->width;
+            links[l].next = update[l]->next;
+            links[l].width = width + rank[l] + 1u - position;
+            update[l]->next = node;
+            update[l]->width = position - rank[l];
+        } else {
+            update[l]->width++;
+        }
+    }
+    size_++;
+}
+
+template<typename T, typename Compare, typename Allocator>
+T structures::SkipList<T, Compare, Allocator>::unlink(Link** update) {
+    Node* node = update[0]->next;
+    Link* links = node->links();
+    for (std::size_t l = 0u; l < MAX_LEVEL; l++) {
+        if (l < node->height) {
+            update[l]->width += links[l].width - 1u;
+            update[l]->next = links[l].next;
+        } else {
+            update[l]->width--;
+        }
+    }
+    T data = std::move(node->data);
+    deallocate_node(node);
+    size_--;
+    return data;
+}
+
+template<typename T, typename Compare, typename Allocator>
+T structures::SkipList<T, Compare, Allocator>::pop(std::size_t index) {
+    if (empty()) {
+        throw std::out_of_range("lista vazia");
+    }
+    if (index >= size_) {
+        throw std::out_of_range("posicao invalida");
+    }
+    Link* update[MAX_LEVEL];
+    search_index(index, update);
+    return unlink(update);
+}
+
+template<typename T, typename Compare, typename Allocator>
+T structures::SkipList<T, Compare, Allocator>::pop_front() {
+    return pop(0u);
+}
+
+template<typename T, typename Compare, typename Allocator>
+T structures::SkipList<T, Compare, Allocator>::pop_back() {
+    if (empty()) {
+        throw std::out_of_range("lista vazia");
+    }
+    return pop(size_ - 1u);
+}
+
+template<typename T, typename Compare, typename Allocator>
+void structures::SkipList<T, Compare, Allocator>::remove(const T& data) {
+    Link* update[MAX_LEVEL];
+    search(data, false, update, nullptr);
+    Node* node = update[0]->next;
+    if (node == nullptr || comp_(data, node->data)) {
+        throw std::out_of_range("elemento nao encontrado");
+    }
+    unlink(update);
+}
+
+template<typename T, typename Compare, typename Allocator>
+bool structures::SkipList<T, Compare, Allocator>::empty() const {
+    return size_ == 0u;
+}
+
+template<typename T, typename Compare, typename Allocator>
+bool structures::SkipList<T, Compare, Allocator>::contains(
+    const T& data) const {
+    return find(data) != size_;
+}
+
+template<typename T, typename Compare, typename Allocator>
+const T& structures::SkipList<T, Compare, Allocator>::at(
+    std::size_t index) const {
+    if (index >= size_) {
+        throw std::out_of_range("posicao invalida");
+    }
+    Link* update[MAX_LEVEL];
+    search_index(index, update);
+    return update[0]->next->data;
+}
+
+template<typename T, typename Compare, typename Allocator>
+std::size_t structures::SkipList<T, Compare, Allocator>::find(
+    const T& data) const {
+    Link* update[MAX_LEVEL];
+    std::size_t rank[MAX_LEVEL];
+    search(data, false, update, rank);
+    Node* node = update[0]->next;
+    if (node == nullptr || comp_(data, node->data)) {
+        return size_;
+    }
+    return rank[0];
+}
+
+template<typename T, typename Compare, typename Allocator>
+std::size_t structures::SkipList<T, Compare, Allocator>::size() const {
+    return size_;
+}
+
+template<typename T, typename Compare, typename Allocator>
+typename structures::SkipList<T, Compare, Allocator>::const_iterator
+structures::SkipList<T, Compare, Allocator>::begin() const {
+    return const_iterator(head_[0].next);
+}
+
+template<typename T, typename Compare, typename Allocator>
+typename structures::SkipList<T, Compare, Allocator>::const_iterator
+structures::SkipList<T, Compare, Allocator>::end() const {
+    return const_iterator(nullptr);
+}
+
+template<typename T, typename Compare, typename Allocator>
+Allocator structures::SkipList<T, Compare, Allocator>::get_allocator() const {
+    return alloc_;
+}
+
+#endif
@@ -0,0 +1,248 @@
+#ifndef STRUCTURES_SEGMENTED_STACK_H
+#define STRUCTURES_SEGMENTED_STACK_H
+
+#include <cstdint>  // std::size_t
+#include <memory>  // std::allocator, std::allocator_traits
+#include <memory_resource>  // std::pmr::polymorphic_allocator
+#include <stdexcept>  // C++ exceptions
+#include <utility>  // std::move
+
+namespace structures {
+
+template<typename T, typename Allocator = std::allocator<T>>
+//! pilha que cresce por segmentos encadeados de tamanho geometrico;
+//! empilhar nunca move os elementos ja empilhados
+class SegmentedStack {
+ public:
+    //! construtor padrao
+    explicit SegmentedStack(const Allocator& alloc = Allocator());
+    //! destrutor
+    ~SegmentedStack();
+    SegmentedStack(const SegmentedStack&) = delete;
+    SegmentedStack& operator=(const SegmentedStack&) = delete;
+    //! empilha
+    void push(const T& data);
+    //! desempilha
+    T pop();
+    //! retorna o topo
+    T& top();
+    //! limpa a pilha (mantem os segmentos)
+    void clear();
+    //! garante capacidade para pelo menos n elementos, mantida pelo pop
+    void reserve(std::size_t n);
+    //! devolve os segmentos vazios acima do topo e esquece a reserva
+    void shrink();
+    //! tamanho atual
+    std::size_t size() const;
+    //! capacidade somando todos os segmentos
+    std::size_t max_size() const;
+    //! verifica se vazia
+    bool empty() const;
+
+ private:
+    struct Segment {
+        T* contents;
+        std::size_t capacity;
+        Segment* prev;  // segmento de baixo
+        Segment* next;  // segmento de cima (reserva, ainda vazio)
+    };
+
+    using Traits = std::allocator_traits<Allocator>;
+    using SegmentAllocator =
+        typename Traits::template rebind_alloc<Segment>;
+    using SegmentTraits = std::allocator_traits<SegmentAllocator>;
+
+    static const auto DEFAULT_SIZE = 16u;
+
+    //! aloca um segmento de capacity elementos no fim da cadeia
+    Segment* append_segment(std::size_t capacity);
+    //! devolve o segmento e todos acima dele
+    void release_from(Segment* segment);
+
+    Allocator alloc_;
+    SegmentAllocator segment_alloc_;
+    Segment* bottom_{nullptr};
+    Segment* top_{nullptr};  // segmento com o topo da pilha
+    Segment* last_{nullptr};  // ultimo segmento alocado
+    std::size_t top_size_{0u};  // elementos em top_
+    std::size_t size_{0u};
+    std::size_t max_size_{0u};
+    std::size_t reserved_{0u};  // capacidade pedida em reserve
+};
+
+namespace pmr {
+
+//! SegmentedStack alocando de um std::pmr::memory_resource
+template<typename T>
+using SegmentedStack =
+    structures::SegmentedStack<T, std::pmr::polymorphic_allocator<T>>;
+
+}  // namespace pmr
+
+}  // namespace structures
+
+template<typename T, typename Allocator>
+structures::SegmentedStack<T, Allocator>::SegmentedStack(
+    const Allocator& alloc):
+    alloc_{alloc},
+    segment_alloc_{alloc}
+{}
+
+template<typename T, typename Allocator>
+structures::SegmentedStack<T, Allocator>::~SegmentedStack() {
+    release_from(bottom_);
+}
+
+template<typename T, typename Allocator>
+typename structures::SegmentedStack<T, Allocator>::Segment*
+structures::SegmentedStack<T, Allocator>::append_segment(
+    std::size_t capacity) {
+    T* contents = Traits::allocate(alloc_, capacity);
+    std::size_t i = 0u;
+    try {
+        for (; i < capacity; i++) {
+            Traits::construct(alloc_, contents + i);
+        }
+    } catch (...) {
+        while (i > 0u) {
+            Traits::destroy(alloc_, contents + --i);
+        }
+        Traits::deallocate(alloc_, contents, capacity);
+        throw;
+    }
+    Segment* segment;
+    try {
+        segment = SegmentTraits::allocate(segment_alloc_, 1u);
+    } catch (...) {
+        for (i = 0u; i < capacity; i++) {
+            Traits::destroy(alloc_, contents + i);
+        }
+        Traits::deallocate(alloc_, contents, capacity);
+        throw;
+    }
+    SegmentTraits::construct(segment_alloc_, segment,
+                             Segment{contents, capacity, last_, nullptr});
+    if (last_ == nullptr) {
+        bottom_ = segment;
+    } else {
+        last_->next = segment;
+    }
+    last_ = segment;
+    max_size_ += capacity;
+    return segment;
+}
+
+template<typename T, typename Allocator>
+void structures::SegmentedStack<T, Allocator>::release_from(
+    Segment* segment) {
+    if (segment == nullptr) {
+        return;
+    }
+    last_ = segment->prev;
+    if (last_ == nullptr) {
+        bottom_ = nullptr;
+    } else {
+        last_->next = nullptr;
+    }
+    while (segment != nullptr) {
+        Segment* next = segment->next;
+        for (std::size_t i = 0u; i < segment->capacity; i++) {
+            Traits::destroy(alloc_, segment->contents + i);
+        }
+        Traits::deallocate(alloc_, segment->contents, segment->capacity);
+        max_size_ -= segment->capacity;
+        SegmentTraits::destroy(segment_alloc_, segment);
+        SegmentTraits::deallocate(segment_alloc_, segment, 1u);
+        segment = next;
+    }
+}
+
+template<typename T, typename Allocator>
+void structures::SegmentedStack<T, Allocator>::push(const T& data) {
+    if (top_ == nullptr) {
+        top_ = bottom_ != nullptr ? bottom_ : append_segment(DEFAULT_SIZE);
+        top_size_ = 0u;
+    } else if (top_size_ == top_->capacity) {
+        // segmento cheio: usa a reserva de cima ou aloca o dobro
+        top_ = top_->next != nullptr ? top_->next
+                                     : append_segment(top_->capacity * 2u);
+        top_size_ = 0u;
+    }
+    top_->contents[top_size_] = data;
+    top_size_++;
+    size_++;
+}
+
+template<typename T, typename Allocator>
+T structures::SegmentedStack<T, Allocator>::pop() {
+    if (empty()) {
+        throw std::out_of_range("pilha vazia");
+    }
+    top_size_--;
+    size_--;
+    T data = std::move(top_->contents[top_size_]);
+    if (top_size_ == 0u && top_->prev != nullptr) {
+        // histerese: o segmento esvaziado fica como reserva; acima dele so
+        // sobrevive o que ainda for preciso para a capacidade de reserve
+        while (last_ != top_ && max_size_ - last_->capacity >= reserved_) {
+            release_from(last_);
+        }
+        top_ = top_->prev;
+        top_size_ = top_->capacity;
+    }
+    return data;
+}
+
+template<typename T, typename Allocator>
+T& structures::SegmentedStack<T, Allocator>::top() {
+    if (empty()) {
+        throw std::out_of_range("pilha vazia");
+    }
+    return top_->contents[top_size_ - 1u];
+}
+
+template<typename T, typename Allocator>
+void structures::SegmentedStack<T, Allocator>::clear() {
+    top_ = bottom_;
+    top_size_ = 0u;
+    size_ = 0u;
+}
+
+template<typename T, typename Allocator>
+void structures::SegmentedStack<T, Allocator>::reserve(std::size_t n) {
+    if (n > reserved_) {
+        reserved_ = n;
+    }
+    while (max_size_ < n) {
+        append_segment(last_ != nullptr ? last_->capacity * 2u : DEFAULT_SIZE);
+    }
+}
+
+template<typename T, typename Allocator>
+void structures::SegmentedStack<T, Allocator>::shrink() {
+    reserved_ = 0u;
+    if (empty()) {
+        release_from(bottom_);
+        top_ = nullptr;
+        top_size_ = 0u;
+    } else {
+        release_from(top_->next);
+    }
+}
+
+template<typename T, typename Allocator>
+std::size_t structures::SegmentedStack<T, Allocator>::size() const {
+    return size_;
+}
+
+template<typename T, typename Allocator>
+std::size_t structures::SegmentedStack<T, Allocator>::max_size() const {
+    return max_size_;
+}
+
+template<typename T, typename Allocator>
+bool structures::SegmentedStack<T, Allocator>::empty() const {
+    return size_ == 0u;
+}
+
+#endif
@@ -0,0 +1,318 @@
+#ifndef STRUCTURES_AGGREGATE_H
+#define STRUCTURES_AGGREGATE_H
+
+#include <cstdint>  // std::size_t
+#include <memory>  // std::allocator, std::allocator_traits
+#include <memory_resource>  // std::pmr::polymorphic_allocator
+#include <stdexcept>  // C++ exceptions
+
+#include "array_stack.h"
+
+namespace structures {
+
+//! operacao de agregado: menor dos dois
+template<typename T>
+struct MinOf {
+    const T& operator()(const T& a, const T& b) const {
+        return b < a ? b : a;
+    }
+};
+
+//! operacao de agregado: maior dos dois
+template<typename T>
+struct MaxOf {
+    const T& operator()(const T& a, const T& b) const {
+        return a < b ? b : a;
+    }
+};
+
+template<typename T, typename Op, typename Allocator = std::allocator<T>>
+//! pilha em que cada entrada guarda o agregado (Op associativa) de todos
+//! os elementos abaixo dela; aggregate() e O(1)
+class AggregateStack {
+ public:
+    //! construtor padrao
+    explicit AggregateStack(const Allocator& alloc = Allocator());
+    //! construtor com capacidade maxima
+    explicit AggregateStack(std::size_t max, const Op& op = Op(),
+                            const Allocator& alloc = Allocator());
+    //! empilha
+    void push(const T& data);
+    //! desempilha
+    T pop();
+    //! retorna o topo
+    const T& top() const;
+    //! Op aplicada da base ao topo
+    const T& aggregate() const;
+    //! limpa
+    void clear();
+    //! tamanho atual
+    std::size_t size() const;
+    //! capacidade maxima
+    std::size_t max_size() const;
+    //! verifica se vazia
+    bool empty() const;
+    //! verifica se cheia
+    bool full() const;
+
+ private:
+    struct Entry {
+        T value;
+        T aggregate;  // Op(base, ..., value)
+    };
+
+    using EntryAllocator = typename std::allocator_traits<Allocator>::
+        template rebind_alloc<Entry>;
+
+    Op op_;
+    ArrayStack<Entry, EntryAllocator> stack_;
+};
+
+template<typename T, typename Op, typename Allocator = std::allocator<T>>
+//! fila com agregado em O(1) amortizado, feita com duas pilhas:
+//! insere em in_, retira de out_ e, quando out_ esvazia, transfere in_
+//! para out_ recalculando os agregados no sentido contrario
+class AggregateQueue {
+ public:
+    //! construtor padrao
+    explicit AggregateQueue(const Allocator& alloc = Allocator());
+    //! construtor com capacidade maxima
+    explicit AggregateQueue(std::size_t max, const Op& op = Op(),
+                            const Allocator& alloc = Allocator());
+    //! insere no fim
+    void enqueue(const T& data);
+    //! retira do inicio
+    T dequeue();
+    //! primeiro elemento
+    const T& front();
+    //! Op aplicada do primeiro ao ultimo elemento
+    T aggregate() const;
+    //! limpa
+    void clear();
+    //! tamanho atual
+    std::size_t size() const;
+    //! capacidade maxima
+    std::size_t max_size() const;
+    //! verifica se vazia
+    bool empty() const;
+    //! verifica se cheia
+    bool full() const;
+
+ private:
+    struct Entry {
+        T value;
+        T aggregate;
+    };
+
+    using EntryAllocator = typename std::allocator_traits<Allocator>::
+        template rebind_alloc<Entry>;
+
+    //! move in_ para out_ (so quando out_ esta vazia)
+    void transfer();
+
+    Op op_;
+    std::size_t max_size_;
+    ArrayStack<Entry, EntryAllocator> in_;  // agregado: Op(antigo, ..., novo)
+    ArrayStack<Entry, EntryAllocator> out_;  // agregado: Op(topo, ..., base)
+
+    static const auto DEFAULT_SIZE = 10u;
+};
+
+//! atalhos para janelas deslizantes de minimo e maximo
+template<typename T>
+using MinStack = AggregateStack<T, MinOf<T>>;
+template<typename T>
+using MaxStack = AggregateStack<T, MaxOf<T>>;
+template<typename T>
+using MinQueue = AggregateQueue<T, MinOf<T>>;
+template<typename T>
+using MaxQueue = AggregateQueue<T, MaxOf<T>>;
+
+namespace pmr {
+
+//! AggregateStack alocando de um std::pmr::memory_resource
+template<typename T, typename Op>
+using AggregateStack =
+    structures::AggregateStack<T, Op, std::pmr::polymorphic_allocator<T>>;
+
+//! AggregateQueue alocando de um std::pmr::memory_resource
+template<typename T, typename Op>
+using AggregateQueue =
+    structures::AggregateQueue<T, Op, std::pmr::polymorphic_allocator<T>>;
+
+}  // namespace pmr
+
+}  // namespace structures
+
+template<typename T, typename Op, typename Allocator>
+structures::AggregateStack<T, Op, Allocator>::AggregateStack(
+    const Allocator& alloc):
+    stack_{EntryAllocator(alloc)}
+{}
+
+template<typename T, typename Op, typename Allocator>
+structures::AggregateStack<T, Op, Allocator>::AggregateStack(
+    std::size_t max, const Op& op, const Allocator& alloc):
+    op_{op},
+    stack_{max, EntryAllocator(alloc)}
+{}
+
+template<typename T, typename Op, typename Allocator>
+void structures::AggregateStack<T, Op, Allocator>::push(const T& data) {
+    if (stack_.empty()) {
+        stack_.push(Entry{data, data});
+    } else {
+        stack_.push(Entry{data, op_(stack_.top().aggregate, data)});
+    }
+}
+
+template<typename T, typename Op, typename Allocator>
+T structures::AggregateStack<T, Op, Allocator>::pop() {
+    return stack_.pop().value;
+}
+
+template<typename T, typename Op, typename Allocator>
+const T& structures::AggregateStack<T, Op, Allocator>::top() const {
+    if (empty()) {
+        throw std::out_of_range("pilha vazia");
+    }
+    return stack_.top().value;
+}
+
+template<typename T, typename Op, typename Allocator>
+const T& structures::AggregateStack<T, Op, Allocator>::aggregate() const {
+    if (empty()) {
+        throw std::out_of_range("pilha vazia");
+    }
+    return stack_.top().aggregate;
+}
+
+template<typename T, typename Op, typename Allocator>
+void structures::AggregateStack<T, Op, Allocator>::clear() {
+    stack_.clear();
+}
+
+template<typename T, typename Op, typename Allocator>
+std::size_t structures::AggregateStack<T, Op, Allocator>::size() const {
+    return stack_.size();
+}
+
+template<typename T, typename Op, typename Allocator>
+std::size_t structures::AggregateStack<T, Op, Allocator>::max_size() const {
+    return stack_.max_size();
+}
+
+template<typename T, typename Op, typename Allocator>
+bool structures::AggregateStack<T, Op, Allocator>::empty() const {
+    return stack_.empty();
+}
+
+template<typename T, typename Op, typename Allocator>
+bool structures::AggregateStack<T, Op, Allocator>::full() const {
+    return stack_.full();
+}
+
+template<typename T, typename Op, typename Allocator>
+structures::AggregateQueue<T, Op, Allocator>::AggregateQueue(
+    const Allocator& alloc):
+    AggregateQueue(DEFAULT_SIZE, Op(), alloc)
+{}
+
+template<typename T, typename Op, typename Allocator>
+structures::AggregateQueue<T, Op, Allocator>::AggregateQueue(
+    std::size_t max, const Op& op, const Allocator& alloc):
+    op_{op},
+    max_size_{max},
+    in_{max, EntryAllocator(alloc)},
+    out_{max, EntryAllocator(alloc)}
+{}
+
+template<typename T, typename Op, typename Allocator>
+void structures::AggregateQueue<T, Op, Allocator>::transfer() {
+    // cada elemento passa uma unica vez de in_ para out_
+    while (!in_.empty()) {
+        T data = in_.pop().value;
+        if (out_.empty()) {
+            out_.push(Entry{data, data});
+        } else {
+            out_.push(Entry{data, op_(data, out_.top().aggregate)});
+        }
+    }
+}
+
+template<typename T, typename Op, typename Allocator>
+void structures::AggregateQueue<T, Op, Allocator>::enqueue(const T& data) {
+    if (full()) {
+        throw std::out_of_range("fila cheia");
+    }
+    if (in_.empty()) {
+        in_.push(Entry{data, data});
+    } else {
+        in_.push(Entry{data, op_(in_.top().aggregate, data)});
+    }
+}
+
+template<typename T, typename Op, typename Allocator>
+T structures::AggregateQueue<T, Op, Allocator>::dequeue() {
+    if (empty()) {
+        throw std::out_of_range("fila vazia");
+    }
+    if (out_.empty()) {
+        transfer();
+    }
+    return out_.pop().value;
+}
+
+template<typename T, typename Op, typename Allocator>
+const T& structures::AggregateQueue<T, Op, Allocator>::front() {
+    if (empty()) {
+        throw std::out_of_range("fila vazia");
+    }
+    if (out_.empty()) {
+        transfer();
+    }
+    return out_.top().value;
+}
+
+template<typename T, typename Op, typename Allocator>
+T structures::AggregateQueue<T, Op, Allocator>::aggregate() const {
+    if (empty()) {
+        throw std::out_of_range("fila vazia");
+    }
+    if (out_.empty()) {
+        return in_.top().aggregate;
+    }
+    if (in_.empty()) {
+        return out_.top().aggregate;
+    }
+    // out_ tem os mais antigos, in_ os mais novos
+    return op_(out_.top().aggregate, in_.top().aggregate);
+}
+
+template<typename T, typename Op, typename Allocator>
+void structures::AggregateQueue<T, Op, Allocator>::clear() {
+    in_.clear();
+    out_.clear();
+}
+
+template<typename T, typename Op, typename Allocator>
+std::size_t structures::AggregateQueue<T, Op, Allocator>::size() const {
+    return in_.size() + out_.size();
+}
+
+template<typename T, typename Op, typename Allocator>
+std::size_t structures::AggregateQueue<T, Op, Allocator>::max_size() const {
+    return max_size_;
+}
+
+template<typename T, typename Op, typename Allocator>
+bool structures::AggregateQueue<T, Op, Allocator>::empty() const {
+    return size() == 0u;
+}
+
+template<typename T, typename Op, typename Allocator>
+bool structures::AggregateQueue<T, Op, Allocator>::full() const {
+    return size() == max_size_;
+}
+
+#endif
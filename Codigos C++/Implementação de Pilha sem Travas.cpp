@@ -0,0 +1,279 @@
+#ifndef STRUCTURES_LOCK_FREE_STACK_H
+#define STRUCTURES_LOCK_FREE_STACK_H
+
+#include <atomic>  // std::atomic
+#include <cstdint>  // std::uint32_t, std::uint64_t
+#include <memory>  // std::allocator, std::allocator_traits
+#include <memory_resource>  // std::pmr::polymorphic_allocator
+#include <stdexcept>  // C++ exceptions
+#include <utility>  // std::move
+
+namespace structures {
+
+template<typename T, typename Allocator = std::allocator<T>>
+//! pilha sem travas (Treiber) com vetor de eliminacao;
+//! os nodos vem de um vetor fixo e o topo guarda indice + etiqueta,
+//! entao um nodo reciclado nao confunde o CAS (problema ABA)
+class LockFreeStack {
+ public:
+    //! construtor com capacidade maxima
+    explicit LockFreeStack(std::size_t max,
+                           const Allocator& alloc = Allocator());
+    //! destrutor
+    ~LockFreeStack();
+    LockFreeStack(const LockFreeStack&) = delete;
+    LockFreeStack& operator=(const LockFreeStack&) = delete;
+    //! empilha; false se a capacidade acabou
+    bool try_push(const T& data);
+    //! desempilha em data; false se vazia
+    bool try_pop(T& data);
+    //! verifica se vazia (aproximado se houver operacoes concorrentes)
+    bool empty() const;
+    //! capacidade maxima
+    std::size_t max_size() const;
+
+ private:
+    static const std::uint32_t NIL = 0xffffffffu;  // fim da lista
+    static const std::uint32_t EMPTY = NIL;  // posicao de troca livre
+    static const std::uint32_t TAKEN = NIL - 1u;  // oferta aceita
+    static const auto ELIMINATION_SIZE = 8u;
+    static const auto ELIMINATION_SPINS = 128u;
+
+    struct Node {
+        T data;
+        std::atomic<std::uint32_t> next;
+    };
+
+    //! posicao do vetor de eliminacao, uma por linha de cache
+    struct alignas(64) Exchanger {
+        std::atomic<std::uint32_t> value{EMPTY};
+    };
+
+    using NodeAllocator =
+        typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+    using NodeTraits = std::allocator_traits<NodeAllocator>;
+
+    static std::uint32_t index_of(std::uint64_t head);
+    static std::uint64_t pack(std::uint64_t old, std::uint32_t index);
+
+    //! retira um nodo da lista head; NIL se vazia
+    std::uint32_t pop_list(std::atomic<std::uint64_t>& head);
+    //! coloca o nodo index na lista head
+    void push_list(std::atomic<std::uint64_t>& head, std::uint32_t index);
+    //! oferece o nodo index a um pop concorrente; true se foi aceito
+    bool eliminate_push(std::uint32_t index);
+    //! procura uma oferta de push concorrente; NIL se nao achou
+    std::uint32_t eliminate_pop();
+    //! posicao pseudoaleatoria do vetor de eliminacao
+    static Exchanger& pick(Exchanger* exchangers);
+
+    NodeAllocator alloc_;
+    Node* nodes;
+    std::size_t max_size_;
+    alignas(64) std::atomic<std::uint64_t> top_;
+    alignas(64) std::atomic<std::uint64_t> free_;
+    Exchanger exchangers_[ELIMINATION_SIZE];
+};
+
+namespace pmr {
+
+//! LockFreeStack alocando de um std::pmr::memory_resource
+template<typename T>
+using LockFreeStack =
+    structures::LockFreeStack<T, std::pmr::polymorphic_allocator<T>>;
+
+}  // namespace pmr
+
+}  // namespace structures
+
+template<typename T, typename Allocator>
+structures::LockFreeStack<T, Allocator>::LockFreeStack(std::size_t max,
+                                                       const Allocator& alloc):
+    alloc_{alloc},
+    max_size_{max} {
+    if (max >= TAKEN) {
+        throw std::out_of_range("Capacidade grande demais");
+    }
+    nodes = NodeTraits::allocate(alloc_, max_size_);
+    std::size_t i = 0u;
+    try {
+        for (; i < max_size_; i++) {
+            NodeTraits::construct(alloc_, nodes + i);
+            // todos os nodos comecam na lista livre, em ordem
+            nodes[i].next.store(i + 1u < max_size_ ?
+                                    static_cast<std::uint32_t>(i + 1u) : NIL,
+                                std::memory_order_relaxed);
+        }
+    } catch (...) {
+        while (i > 0u) {
+            NodeTraits::destroy(alloc_, nodes + --i);
+        }
+        NodeTraits::deallocate(alloc_, nodes, max_size_);
+        throw;
+    }
+    top_.store(NIL, std::memory_order_relaxed);
+    free_.store(max_size_ > 0u ? 0u : NIL, std::memory_order_relaxed);
+}
+
+template<typename T, typename Allocator>
+structures::LockFreeStack<T, Allocator>::~LockFreeStack() {
+    for (std::size_t i = 0u; i < max_size_; i++) {
+        NodeTraits::destroy(alloc_, nodes + i);
+    }
+    NodeTraits::deallocate(alloc_, nodes, max_size_);
+}
+
+template<typename T, typename Allocator>
+std::uint32_t structures::LockFreeStack<T, Allocator>::index_of(
+    std::uint64_t head) {
+    return static_cast<std::uint32_t>(head);
+}
+
+template<typename T, typename Allocator>
+std::uint64_t structures::LockFreeStack<T, Allocator>::pack(
+    std::uint64_t old, std::uint32_t index) {
+    // etiqueta nos 32 bits altos, incrementada a cada troca do topo
+    return (((old >> 32) + 1u) << 32) | index;
+}
+
+template<typename T, typename Allocator>
+std::uint32_t structures::LockFreeStack<T, Allocator>::pop_list(
+    std::atomic<std::uint64_t>& head) {
+    std::uint64_t old = head.load(std::memory_order_acquire);
+    for (;;) {
+        std::uint32_t index = index_of(old);
+        if (index == NIL) {
+            return NIL;
+        }
+        std::uint32_t next = nodes[index].next.load(std::memory_order_relaxed);
+        if (head.compare_exchange_weak(old, pack(old, next),
+                                       std::memory_order_acquire)) {
+            return index;
+        }
+    }
+}
+
+template<typename T, typename Allocator>
+void structures::LockFreeStack<T, Allocator>::push_list(
+    std::atomic<std::uint64_t>& head, std::uint32_t index) {
+    std::uint64_t old = head.load(std::memory_order_relaxed);
+    do {
+        nodes[index].next.store(index_of(old), std::memory_order_relaxed);
+    } while (!head.compare_exchange_weak(old, pack(old, index),
+                                         std::memory_order_release,
+                                         std::memory_order_relaxed));
+}
+
+template<typename T, typename Allocator>
+typename structures::LockFreeStack<T, Allocator>::Exchanger&
+structures::LockFreeStack<T, Allocator>::pick(Exchanger* exchangers) {
+    thread_local std::uint32_t seed = static_cast<std::uint32_t>(
+        reinterpret_cast<std::uintptr_t>(&seed) >> 4) | 1u;
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    return exchangers[seed % ELIMINATION_SIZE];
+}
+
+template<typename T, typename Allocator>
+bool structures::LockFreeStack<T, Allocator>::eliminate_push(
+    std::uint32_t index) {
+    Exchanger& slot = pick(exchangers_);
+    std::uint32_t expected = EMPTY;
+    if (!slot.value.compare_exchange_strong(expected, index,
+                                            std::memory_order_release,
+                                            std::memory_order_relaxed)) {
+        return false;
+    }
+    for (auto i = 0u; i < ELIMINATION_SPINS; i++) {
+        if (slot.value.load(std::memory_order_acquire) == TAKEN) {
+            slot.value.store(EMPTY, std::memory_order_release);
+            return true;
+        }
+    }
+    // ninguem apareceu: retira a oferta, a menos que um pop a tenha pego
+    expected = index;
+    if (slot.value.compare_exchange_strong(expected, EMPTY,
+                                           std::memory_order_relaxed)) {
+        return false;
+    }
+    slot.value.store(EMPTY, std::memory_order_release);
+    return true;
+}
+
+template<typename T, typename Allocator>
+std::uint32_t structures::LockFreeStack<T, Allocator>::eliminate_pop() {
+    Exchanger& slot = pick(exchangers_);
+    std::uint32_t offer = slot.value.load(std::memory_order_relaxed);
+    if (offer >= TAKEN) {
+        return NIL;
+    }
+    if (slot.value.compare_exchange_strong(offer, TAKEN,
+                                           std::memory_order_acquire,
+                                           std::memory_order_relaxed)) {
+        return offer;
+    }
+    return NIL;
+}
+
+template<typename T, typename Allocator>
+bool structures::LockFreeStack<T, Allocator>::try_push(const T& data) {
+    std::uint32_t index = pop_list(free_);
+    if (index == NIL) {
+        return false;
+    }
+    nodes[index].data = data;
+    for (;;) {
+        // uma tentativa no topo; se houver disputa, tenta eliminar
+        std::uint64_t old = top_.load(std::memory_order_relaxed);
+        nodes[index].next.store(index_of(old), std::memory_order_relaxed);
+        if (top_.compare_exchange_strong(old, pack(old, index),
+                                         std::memory_order_release,
+                                         std::memory_order_relaxed)) {
+            return true;
+        }
+        if (eliminate_push(index)) {
+            return true;
+        }
+    }
+}
+
+template<typename T, typename Allocator>
+bool structures::LockFreeStack<T, Allocator>::try_pop(T& data) {
+    for (;;) {
+        std::uint64_t old = top_.load(std::memory_order_acquire);
+        std::uint32_t index = index_of(old);
+        if (index == NIL) {
+            index = eliminate_pop();
+            if (index == NIL) {
+                return false;
+            }
+        } else {
+            std::uint32_t next =
+                nodes[index].next.load(std::memory_order_relaxed);
+            if (!top_.compare_exchange_strong(old, pack(old, next),
+                                              std::memory_order_acquire,
+                                              std::memory_order_relaxed)) {
+                index = eliminate_pop();
+                if (index == NIL) {
+                    continue;
+                }
+            }
+        }
+        data = std::move(nodes[index].data);
+        push_list(free_, index);
+        return true;
+    }
+}
+
+template<typename T, typename Allocator>
+bool structures::LockFreeStack<T, Allocator>::empty() const {
+    return index_of(top_.load(std::memory_order_acquire)) == NIL;
+}
+
+template<typename T, typename Allocator>
+std::size_t structures::LockFreeStack<T, Allocator>::max_size() const {
+    return max_size_;
+}
+
+#endif
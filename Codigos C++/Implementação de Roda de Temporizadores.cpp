@@ -0,0 +1,221 @@
+#ifndef STRUCTURES_TIMER_WHEEL_H
+#define STRUCTURES_TIMER_WHEEL_H
+
+#include <cstdint>  // std::size_t, std::uint64_t
+#include <functional>  // std::function
+#include <utility>  // std::move
+
+#include "intrusive_list.h"
+
+namespace structures {
+
+class TimerWheel;
+
+//! temporizador de propriedade do usuario; armado, fica ligado por
+//! gancho a uma posicao da roda (sem alocacao por agendamento)
+class Timer {
+ public:
+    explicit Timer(std::function<void()> callback = nullptr);
+    //! destruir um temporizador armado o cancela
+    ~Timer();
+    Timer(const Timer&) = delete;
+    Timer& operator=(const Timer&) = delete;
+
+    //! troca a funcao chamada ao expirar
+    void callback(std::function<void()> callback);
+    //! true se agendado e ainda nao expirado nem cancelado
+    bool armed() const;
+    //! tick em que expira (valido se armado)
+    std::uint64_t expires() const;
+
+ private:
+    friend class TimerWheel;
+
+    ListHook<Timer> hook_;
+    std::function<void()> callback_;
+    std::uint64_t expires_{0u};
+    TimerWheel* wheel_{nullptr};
+    IntrusiveList<Timer, &Timer::hook_>* slot_{nullptr};
+};
+
+//! roda de temporizadores hierarquica: LEVELS rodas de SLOTS posicoes,
+//! cada nivel SLOTS vezes mais grosso que o anterior. Agendar e cancelar
+//! sao O(1); advance expira uma posicao inteira por tick e, quando um
+//! nivel completa a volta, redistribui a posicao seguinte do nivel acima
+class TimerWheel {
+ public:
+    static const std::size_t SLOT_BITS = 6u;
+    static const std::size_t SLOTS = 1u << SLOT_BITS;
+    static const std::size_t LEVELS = 4u;
+
+    TimerWheel() = default;
+    //! desarma os temporizadores restantes sem chama-los
+    ~TimerWheel();
+    TimerWheel(const TimerWheel&) = delete;
+    TimerWheel& operator=(const TimerWheel&) = delete;
+
+    //! arma timer para daqui a delay ticks (no minimo 1); rearma se ja
+    //! estiver armado
+    void schedule(Timer& timer, std::uint64_t delay);
+    //! desarma timer; false se nao estava armado nesta roda
+    bool cancel(Timer& timer);
+    //! avanca ticks ticks chamando os que expirarem; retorna quantos
+    std::size_t advance(std::uint64_t ticks = 1u);
+
+    //! tick atual
+    std::uint64_t now() const;
+    //! temporizadores armados
+    std::size_t size() const;
+    bool empty() const;
+
+ private:
+    using Slot = IntrusiveList<Timer, &Timer::hook_>;
+
+    //! liga timer na posicao que corresponde a sua distancia de now_
+    void place(Timer& timer);
+    //! redistribui a posicao atual do nivel level
+    void cascade(std::size_t level);
+
+    Slot slots_[LEVELS][SLOTS];
+    std::uint64_t now_{0u};
+    std::size_t size_{0u};
+};
+
+}  // namespace structures
+
+inline structures::Timer::Timer(std::function<void()> callback):
+    callback_{std::move(callback)}
+{}
+
+inline structures::Timer::~Timer() {
+    if (wheel_ != nullptr) {
+        wheel_->cancel(*this);
+    }
+}
+
+inline void structures::Timer::callback(std::function<void()> callback) {
+    callback_ = std::move(callback);
+}
+
+inline bool structures::Timer::armed() const {
+    return wheel_ != nullptr;
+}
+
+inline std::uint64_t structures::Timer::expires() const {
+    return expires_;
+}
+
+inline structures::TimerWheel::~TimerWheel() {
+    for (std::size_t level = 0u; level < LEVELS; level++) {
+        for (std::size_t i = 0u; i < SLOTS; i++) {
+            for (Timer& timer : slots_[level][i]) {
+                timer.wheel_ = nullptr;
+                timer.slot_ = nullptr;
+            }
+            slots_[level][i].clear();
+        }
+    }
+}
+
+inline void structures::TimerWheel::place(Timer& timer) {
+    // menor nivel em que a posicao do timer esta a menos de uma volta
+    std::size_t level = 0u;
+    std::uint64_t target = timer.expires_;
+    while (level < LEVELS) {
+        std::size_t shift = level * SLOT_BITS;
+        if ((target >> shift) - (now_ >> shift) < SLOTS) {
+            break;
+        }
+        level++;
+    }
+    if (level == LEVELS) {
+        // alem do alcance: espera na ultima posicao do nivel mais alto e
+        // e redistribuido de novo quando ela chegar
+        level = LEVELS - 1u;
+        target = now_ + ((SLOTS - 1u) << (level * SLOT_BITS));
+    }
+    std::size_t index = (target >> (level * SLOT_BITS)) & (SLOTS - 1u);
+    timer.slot_ = &slots_[level][index];
+    timer.slot_->push_back(timer);
+}
+
+inline void structures::TimerWheel::schedule(Timer& timer,
+                                             std::uint64_t delay) {
+    if (timer.wheel_ != nullptr) {
+        timer.wheel_->cancel(timer);
+    }
+    timer.expires_ = now_ + (delay == 0u ? 1u : delay);
+    timer.wheel_ = this;
+    place(timer);
+    size_++;
+}
+
+inline bool structures::TimerWheel::cancel(Timer& timer) {
+    if (timer.wheel_ != this) {
+        return false;
+    }
+    timer.slot_->remove(timer);
+    timer.slot_ = nullptr;
+    timer.wheel_ = nullptr;
+    size_--;
+    return true;
+}
+
+inline void structures::TimerWheel::cascade(std::size_t level) {
+    std::size_t index = (now_ >> (level * SLOT_BITS)) & (SLOTS - 1u);
+    Slot pending;
+    pending.swap(slots_[level][index]);
+    while (!pending.empty()) {
+        place(pending.pop_front());
+    }
+}
+
+inline std::size_t structures::TimerWheel::advance(std::uint64_t ticks) {
+    std::size_t fired = 0u;
+    for (std::uint64_t t = 0u; t < ticks; t++) {
+        if (size_ == 0u) {
+            // nada armado: pula o resto de uma vez
+            now_ += ticks - t;
+            break;
+        }
+        now_++;
+        // niveis que completaram a volta, do mais alto para o mais baixo,
+        // para que o que desce seja redistribuido de novo no mesmo tick
+        std::size_t top = 0u;
+        while (top + 1u < LEVELS &&
+               (now_ & ((std::uint64_t(1) << ((top + 1u) * SLOT_BITS)) - 1u))
+                   == 0u) {
+            top++;
+        }
+        for (std::size_t level = top; level > 0u; level--) {
+            cascade(level);
+        }
+        Slot& due = slots_[0][now_ & (SLOTS - 1u)];
+        while (!due.empty()) {
+            // um por vez: o callback pode cancelar ou reagendar outros
+            Timer& timer = due.pop_front();
+            timer.slot_ = nullptr;
+            timer.wheel_ = nullptr;
+            size_--;
+            fired++;
+            if (timer.callback_) {
+                timer.callback_();
+            }
+        }
+    }
+    return fired;
+}
+
+inline std::uint64_t structures::TimerWheel::now() const {
+    return now_;
+}
+
+inline std::size_t structures::TimerWheel::size() const {
+    return size_;
+}
+
+inline bool structures::TimerWheel::empty() const {
+    return size_ == 0u;
+}
+
+#endif
@@ -1,15 +1,18 @@
 #ifndef STRUCTURES_ARRAY_LIST_H
 #define STRUCTURES_ARRAY_LIST_H
 
+#include <memory>
+#include <memory_resource>
 #include <stdexcept>
 
 namespace structures {
 
-template <typename T>
+template <typename T, typename Allocator = std::allocator<T>>
 class ArrayList {
 public:
-    ArrayList();
-    explicit ArrayList(std::size_t max_size);
+    explicit ArrayList(const Allocator& alloc = Allocator());
+    explicit ArrayList(std::size_t max_size,
+                       const Allocator& alloc = Allocator());
     ~ArrayList();
 
     void clear();
@@ -31,8 +34,15 @@ public:
     T& operator[](std::size_t index);
     const T& at(std::size_t index) const;
     const T& operator[](std::size_t index) const;
+    Allocator get_allocator() const;
 
 private:
+    using Traits = std::allocator_traits<Allocator>;
+
+    T* allocate_contents(std::size_t n);
+    void deallocate_contents(T* p, std::size_t n);
+
+    Allocator alloc_;
     T* contents;
     std::size_t size_;
     std::size_t max_size_;
@@ -40,36 +50,71 @@ private:
     static const auto DEFAULT_MAX = 10u;
 };
 
-}  // namespace structures
-
-#endif
+namespace pmr {
 
 template <typename T>
-structures::ArrayList<T>::ArrayList() {
+using ArrayList = structures::ArrayList<T, std::pmr::polymorphic_allocator<T>>;
+
+}  // namespace pmr
+
+}  // namespace structures
+
+template <typename T, typename Allocator>
+structures::ArrayList<T, Allocator>::ArrayList(const Allocator& alloc):
+    alloc_{alloc} {
     max_size_ = DEFAULT_MAX;
-    contents = new T[max_size_];
+    contents = allocate_contents(max_size_);
     size_ = 0;
 }
 
-template <typename T>
-structures::ArrayList<T>::ArrayList(std::size_t max) {
+template <typename T, typename Allocator>
+structures::ArrayList<T, Allocator>::ArrayList(std::size_t max,
+                                               const Allocator& alloc):
+    alloc_{alloc} {
     max_size_ = max;
-    contents = new T[max_size_];
+    contents = allocate_contents(max_size_);
     size_ = 0;
 }
 
-template <typename T>
-structures::ArrayList<T>::~ArrayList() {
-    delete[] contents;
+template <typename T, typename Allocator>
+structures::ArrayList<T, Allocator>::~ArrayList() {
+    deallocate_contents(contents, max_size_);
 }
 
-template <typename T>
-void structures::ArrayList<T>::clear() {
+template <typename T, typename Allocator>
+T* structures::ArrayList<T, Allocator>::allocate_contents(std::size_t n) {
+    T* p = Traits::allocate(alloc_, n);
+    std::size_t i = 0;
+    try {
+        for (; i < n; i++) {
+            Traits::construct(alloc_, p + i);
+        }
+    } catch (...) {
+        while (i > 0) {
+            Traits::destroy(alloc_, p + --i);
+        }
+        Traits::deallocate(alloc_, p, n);
+        throw;
+    }
+    return p;
+}
+
+template <typename T, typename Allocator>
+void structures::ArrayList<T, Allocator>::deallocate_contents(T* p,
+                                                              std::size_t n) {
+    for (std::size_t i = 0; i < n; i++) {
+        Traits::destroy(alloc_, p + i);
+    }
+    Traits::deallocate(alloc_, p, n);
+}
+
+template <typename T, typename Allocator>
+void structures::ArrayList<T, Allocator>::clear() {
     size_ = 0;
 }
 
-template <typename T>
-void structures::ArrayList<T>::push_back(const T& data) {
+template <typename T, typename Allocator>
+void structures::ArrayList<T, Allocator>::push_back(const T& data) {
     if (full()) {
         throw std::out_of_range("Lista cheia");
     } else {
@@ -78,8 +123,8 @@ void structures::ArrayList<T>::push_back(const T& data) {
     }
 }
 
-template <typename T>
-void structures::ArrayList<T>::push_front(const T& data) {
+template <typename T, typename Allocator>
+void structures::ArrayList<T, Allocator>::push_front(const T& data) {
     if (full()) {
         throw std::out_of_range("Lista cheia");
     } else {
@@ -91,8 +136,9 @@ void structures::ArrayList<T>::push_front(const T& data) {
     }
 }
 
-template <typename T>
-void structures::ArrayList<T>::insert(const T& data, std::size_t index) {
+template <typename T, typename Allocator>
+void structures::ArrayList<T, Allocator>::
+insert(const T& data, std::size_t index) {
     if (full()) {
         throw std::out_of_range("Lista cheia");
     } else if (index > size_) {
@@ -106,8 +152,8 @@ void structures::ArrayList<T>::insert(const T& data, std::size_t index) {
     }
 }
 
-template <typename T>
-void structures::ArrayList<T>::insert_sorted(const T& data) {
+template <typename T, typename Allocator>
+void structures::ArrayList<T, Allocator>::insert_sorted(const T& data) {
     if (full()) {
         throw std::out_of_range("Lista cheia");
     } else {
@@ -124,8 +170,8 @@ void structures::ArrayList<T>::insert_sorted(const T& data) {
     }
 }
 
-template <typename T>
-T structures::ArrayList<T>::pop(std::size_t index) {
+template <typename T, typename Allocator>
+T structures::ArrayList<T, Allocator>::pop(std::size_t index) {
     if (empty()) {
         throw std::out_of_range("Lista vazia");
     } else if (index >= size_) {
@@ -140,8 +186,8 @@ T structures::ArrayList<T>::pop(std::size_t index) {
     }
 }
 
-template <typename T>
-T structures::ArrayList<T>::pop_back() {
+template <typename T, typename Allocator>
+T structures::ArrayList<T, Allocator>::pop_back() {
     if (empty()) {
         throw std::out_of_range("Lista vazia");
     } else {
@@ -151,8 +197,8 @@ T structures::ArrayList<T>::pop_back() {
     }
 }
 
-template <typename T>
-T structures::ArrayList<T>::pop_front() {
+template <typename T, typename Allocator>
+T structures::ArrayList<T, Allocator>::pop_front() {
     if (empty()) {
         throw std::out_of_range("Lista vazia");
     } else {
@@ -165,8 +211,8 @@ T structures::ArrayList<T>::pop_front() {
     }
 }
 
-template <typename T>
-void structures::ArrayList<T>::remove(const T& data) {
+template <typename T, typename Allocator>
+void structures::ArrayList<T, Allocator>::remove(const T& data) {
     if (empty()) {
         throw std::out_of_range("Lista vazia");
     } else {
@@ -180,18 +226,18 @@ void structures::ArrayList<T>::remove(const T& data) {
     }
 }
 
-template <typename T>
-bool structures::ArrayList<T>::full() const {
+template <typename T, typename Allocator>
+bool structures::ArrayList<T, Allocator>::full() const {
     return size_ == max_size_;
 }
 
-template <typename T>
-bool structures::ArrayList<T>::empty() const {
+template <typename T, typename Allocator>
+bool structures::ArrayList<T, Allocator>::empty() const {
     return size_ == 0;
 }
 
-template <typename T>
-bool structures::ArrayList<T>::contains(const T& data) const {
+template <typename T, typename Allocator>
+bool structures::ArrayList<T, Allocator>::contains(const T& data) const {
     for (std::size_t i = 0; i < size_; i++) {
         if (contents[i] == data) {
             return true;
@@ -200,8 +246,8 @@ bool structures::ArrayList<T>::contains(const T& data) const {
     return false;
 }
 
-template <typename T>
-std::size_t structures::ArrayList<T>::find(const T& data) const {
+template <typename T, typename Allocator>
+std::size_t structures::ArrayList<T, Allocator>::find(const T& data) const {
     if (contains(data)) {
         for (std::size_t i = 0; i < size_; i++) {
             if (contents[i] == data) {
@@ -212,38 +258,46 @@ std::size_t structures::ArrayList<T>::find(const T& data) const {
     return -1;
 }
 
-template <typename T>
-std::size_t structures::ArrayList<T>::size() const {
+template <typename T, typename Allocator>
+std::size_t structures::ArrayList<T, Allocator>::size() const {
     return size_;
 }
 
-template <typename T>
-std::size_t structures::ArrayList<T>::max_size() const {
+template <typename T, typename Allocator>
+std::size_t structures::ArrayList<T, Allocator>::max_size() const {
     return max_size_;
 }
 
-template <typename T>
-T& structures::ArrayList<T>::at(std::size_t index) {
+template <typename T, typename Allocator>
+T& structures::ArrayList<T, Allocator>::at(std::size_t index) {
     if (index < 0 || index >= size_) {
         throw std::out_of_range("Posição inválida");
     }
     return contents[index];
 }
 
-template <typename T>
-T& structures::ArrayList<T>::operator[](std::size_t index) {
+template <typename T, typename Allocator>
+T& structures::ArrayList<T, Allocator>::operator[](std::size_t index) {
     return contents[index];
 }
 
-template <typename T>
-const T& structures::ArrayList<T>::at(std::size_t index) const {
+template <typename T, typename Allocator>
+const T& structures::ArrayList<T, Allocator>::at(std::size_t index) const {
     if (index < 0 || index >= size_) {
         throw std::out_of_range("Posição inválida");
     }
     return contents[index];
 }
 
-template <typename T>
-const T& structures::ArrayList<T>::operator[](std::size_t index) const {
+template <typename T, typename Allocator>
+const T& structures::ArrayList<T, Allocator>::
+operator[](std::size_t index) const {
     return contents[index];
 }
+
+template <typename T, typename Allocator>
+Allocator structures::ArrayList<T, Allocator>::get_allocator() const {
+    return alloc_;
+}
+
+#endif